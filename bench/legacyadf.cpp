@@ -0,0 +1,86 @@
+#include "legacyadf.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QStringList>
+
+#include <functional>
+
+QString LegacyAdf::toPlainText(const QJsonValue& adf)
+{
+    // Port of C# AdfChildToPlainText: walks doc/paragraph/text/hardBreak.
+    QStringList out;
+
+    std::function<void(const QJsonValue&, QStringList&)> walk;
+    walk = [&walk](const QJsonValue& node, QStringList& lines) {
+        if (node.isNull() || node.isUndefined()) return;
+
+        if (node.isArray())
+        {
+            bool first = true;
+            for (const auto& v : node.toArray())
+            {
+                if (!first) lines.append("");
+                first = false;
+                walk(v, lines);
+            }
+            return;
+        }
+
+        if (!node.isObject()) return;
+
+        const auto o = node.toObject();
+        const auto type = o.value("type").toString();
+
+        if (type == "doc")
+        {
+            const auto content = o.value("content").toArray();
+            bool firstPara = true;
+            for (const auto& v : content)
+            {
+                if (!firstPara) lines.append("");
+                firstPara = false;
+                walk(v, lines);
+            }
+            return;
+        }
+
+        if (type == "paragraph")
+        {
+            const auto content = o.value("content").toArray();
+            if (lines.isEmpty()) lines.append(QString());
+            for (const auto& v : content)
+            {
+                walk(v, lines);
+            }
+            return;
+        }
+
+        if (type == "hardBreak")
+        {
+            lines.append(QString());
+            return;
+        }
+
+        if (type == "text")
+        {
+            if (lines.isEmpty()) lines.append(QString());
+            auto current = lines.takeLast();
+            current += o.value("text").toString();
+            lines.append(current);
+            return;
+        }
+
+        // Fallback: walk children if present
+        const auto content = o.value("content");
+        if (content.isArray())
+        {
+            for (const auto& v : content.toArray())
+                walk(v, lines);
+        }
+    };
+
+    walk(adf, out);
+    while (!out.isEmpty() && out.last().trimmed().isEmpty()) out.removeLast();
+    return out.join("\n").trimmed();
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <QJsonValue>
+#include <QString>
+
+// The recursive std::function / QStringList ADF walker that Adf::toPlainText replaced,
+// kept verbatim as the baseline for the ADF benchmark.
+class LegacyAdf
+{
+public:
+    static QString toPlainText(const QJsonValue& adf);
+};
@@ -0,0 +1,337 @@
+// Offline benchmarks: JiraClient against MockJiraServer, plus the CPU-only paths
+// (model rebuilds, ADF conversion). Results print as a table and, with --json, are
+// written out for comparison between builds.
+
+#include "adf.h"
+#include "jira_client.h"
+#include "legacyadf.h"
+#include "mockjiraserver.h"
+#include "ticketsfilterproxy.h"
+#include "ticketsmodel.h"
+#include "ticketstore.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QTimer>
+
+#include <algorithm>
+#include <functional>
+
+namespace {
+
+struct Result
+{
+    QString name;
+    int size{0};
+    QList<double> samplesMs;
+    double work{0};     // units per iteration, for throughput
+    QString unit;       // e.g. "issues", "MB"
+    QString note;
+};
+
+double median(QList<double> v)
+{
+    if (v.isEmpty()) return 0;
+    std::sort(v.begin(), v.end());
+    return v[v.size() / 2];
+}
+
+double percentile(QList<double> v, double p)
+{
+    if (v.isEmpty()) return 0;
+    std::sort(v.begin(), v.end());
+    return v[std::min<qsizetype>(v.size() - 1, qsizetype(p * double(v.size())))];
+}
+
+// Runs `trigger` and spins the event loop until `signal` fires `expected` times.
+template <typename Sender, typename Signal>
+bool waitFor(Sender* sender, Signal signal, const std::function<void()>& trigger, int expected = 1, int timeoutMs = 10 * 60 * 1000)
+{
+    QEventLoop loop;
+    int seen = 0;
+    const auto c = QObject::connect(sender, signal, &loop, [&]() {
+        if (++seen >= expected) loop.exit(0);
+    });
+    QTimer::singleShot(timeoutMs, &loop, [&loop]() { loop.exit(1); });
+    trigger();
+    const bool ok = seen >= expected || loop.exec() == 0;
+    QObject::disconnect(c);
+    return ok;
+}
+
+class Bench
+{
+public:
+    Bench(const QList<int>& sizes, int repeat, int latencyMs, int detailSample)
+        : m_sizes(sizes), m_repeat(repeat), m_latencyMs(latencyMs), m_detailSample(detailSample)
+    {
+    }
+
+    void run()
+    {
+        for (int size : m_sizes)
+        {
+            benchAdf(size);
+
+            MockJiraServer::Options options;
+            options.issueCount = size;
+            options.latencyMs = m_latencyMs;
+            MockJiraServer server(options);
+            if (!server.listen())
+            {
+                QTextStream(stderr) << "mock server failed to listen\n";
+                return;
+            }
+
+            // Every client gets a clean working directory: the caches live next to it.
+            QTemporaryDir dir;
+            QDir::setCurrent(dir.path());
+            JiraClient client;
+            client.configure(server.baseUrl(), "bench", "token");
+
+            const auto tickets = benchMyTickets(client, server, size);
+            benchDetails(client, server, size);
+            benchModel(tickets, size);
+            benchStore(tickets, size);
+        }
+    }
+
+    const QList<Result>& results() const { return m_results; }
+
+private:
+    void add(Result r)
+    {
+        QTextStream out(stdout);
+        const double med = median(r.samplesMs);
+        out << qSetFieldWidth(28) << Qt::left << r.name << qSetFieldWidth(9) << Qt::right << r.size
+            << qSetFieldWidth(12) << QString::number(med, 'f', 2) << qSetFieldWidth(0) << " ms"
+            << qSetFieldWidth(12) << QString::number(percentile(r.samplesMs, 0.0), 'f', 2) << qSetFieldWidth(0) << " min";
+        if (r.work > 0 && med > 0)
+            out << "  " << QString::number(r.work / (med / 1000.0), 'f', 1) << ' ' << r.unit << "/s";
+        if (!r.note.isEmpty())
+            out << "  " << r.note;
+        out << Qt::endl;
+        m_results.append(std::move(r));
+    }
+
+    void benchAdf(int size)
+    {
+        // One document with `size` top-level blocks; 100k blocks is several MB of JSON.
+        const QJsonValue doc = MockJiraServer::descriptionAdf(size, 1);
+        const double mb = double(QJsonDocument(doc.toObject()).toJson(QJsonDocument::Compact).size()) / (1024.0 * 1024.0);
+
+        const auto measure = [&](const QString& name, QString (*convert)(const QJsonValue&)) {
+            Result r{name, size, {}, mb, "MB", QString("%1 MB").arg(mb, 0, 'f', 2)};
+            qsizetype chars = 0;
+            for (int i = 0; i < m_repeat; ++i)
+            {
+                QElapsedTimer t;
+                t.start();
+                chars += convert(doc).size();
+                r.samplesMs.append(double(t.nsecsElapsed()) / 1e6);
+            }
+            r.note += QString(", %1 chars out").arg(chars / m_repeat);
+            add(std::move(r));
+        };
+        measure("adf.toPlainText", &Adf::toPlainText);
+        measure("adf.toPlainText.legacy", &LegacyAdf::toPlainText);
+    }
+
+    QList<JiraTicket> benchMyTickets(JiraClient& client, MockJiraServer& server, int size)
+    {
+        QList<JiraTicket> tickets;
+        const auto capture = QObject::connect(&client, &JiraClient::myTicketsReady, [&tickets](const QList<JiraTicket>& t) { tickets = t; });
+
+        Result r{"client.getMyTickets", size, {}, double(size), "issues", {}};
+        quint64 requests = 0;
+        for (int i = 0; i < m_repeat; ++i)
+        {
+            server.resetCounters();
+            QElapsedTimer t;
+            t.start();
+            if (!waitFor(&client, &JiraClient::myTicketsReady, [&client]() { client.getMyTickets(); }))
+                r.note = "TIMEOUT";
+            r.samplesMs.append(double(t.nsecsElapsed()) / 1e6);
+            requests = server.requestCount();
+        }
+        if (tickets.size() != size)
+            r.note += QString(" got %1 tickets").arg(tickets.size());
+        r.note += QString(" %1 requests/run").arg(requests);
+        QObject::disconnect(capture);
+        add(std::move(r));
+        return tickets;
+    }
+
+    void benchDetails(JiraClient& client, MockJiraServer& server, int size)
+    {
+        const int n = std::min(size, m_detailSample);
+
+        // First pass fills the HTTP cache, second pass revalidates (304s).
+        for (const char* name : {"client.getIssueDetails", "client.getIssueDetails.304"})
+        {
+            QHash<QString, qint64> started;
+            QList<double> latencies;
+            QElapsedTimer clock;
+            const auto c = QObject::connect(&client, &JiraClient::issueDetailsReady, [&](const JiraIssueDetails& d) {
+                latencies.append(double(clock.nsecsElapsed() - started.value(d.key)) / 1e6);
+            });
+
+            server.resetCounters();
+            clock.start();
+            const bool ok = waitFor(&client, &JiraClient::issueDetailsReady, [&]() {
+                for (int i = 0; i < n; ++i)
+                {
+                    const auto key = MockJiraServer::issueKey(i);
+                    started.insert(key, clock.nsecsElapsed());
+                    client.getIssueDetails(key);
+                }
+            }, n);
+            const double totalMs = double(clock.nsecsElapsed()) / 1e6;
+            QObject::disconnect(c);
+
+            Result r{name, size, latencies, 0, {}, {}};
+            r.note = QString("%1 issues in %2 ms (%3 issues/s), p95 %4 ms, %5 KB sent")
+                         .arg(n)
+                         .arg(totalMs, 0, 'f', 1)
+                         .arg(totalMs > 0 ? double(n) / (totalMs / 1000.0) : 0.0, 0, 'f', 1)
+                         .arg(percentile(latencies, 0.95), 0, 'f', 2)
+                         .arg(server.bytesSent() / 1024);
+            if (!ok) r.note += " TIMEOUT";
+            add(std::move(r));
+        }
+    }
+
+    void benchModel(const QList<JiraTicket>& tickets, int size)
+    {
+        // A fresh model each time: repeats on one model would take the diff path.
+        Result r{"model.setTickets", size, {}, double(tickets.size()), "issues", {}};
+        for (int i = 0; i < m_repeat; ++i)
+        {
+            TicketsModel model;
+            TicketsFilterProxyModel proxy(&model);
+            QElapsedTimer t;
+            t.start();
+            model.setTickets(tickets);
+            r.samplesMs.append(double(t.nsecsElapsed()) / 1e6);
+        }
+        add(std::move(r));
+
+        // A refresh that changed nothing, diffed against the loaded model.
+        TicketsModel model;
+        TicketsFilterProxyModel proxy(&model);
+        model.setTickets(tickets);
+        Result same{"model.setTickets.unchanged", size, {}, double(tickets.size()), "issues", {}};
+        for (int i = 0; i < m_repeat; ++i)
+        {
+            QElapsedTimer t;
+            t.start();
+            model.setTickets(tickets);
+            same.samplesMs.append(double(t.nsecsElapsed()) / 1e6);
+        }
+        add(std::move(same));
+    }
+
+    void benchStore(const QList<JiraTicket>& tickets, int size)
+    {
+        TicketStore store;
+
+        Result load{"store.assign", size, {}, double(tickets.size()), "issues", {}};
+        for (int i = 0; i < m_repeat; ++i)
+        {
+            QElapsedTimer t;
+            t.start();
+            store.assign(tickets);
+            load.samplesMs.append(double(t.nsecsElapsed()) / 1e6);
+        }
+        add(std::move(load));
+
+        // What every publish pays to hand the list to the model.
+        Result list{"store.toList", size, {}, double(tickets.size()), "issues", {}};
+        for (int i = 0; i < m_repeat; ++i)
+        {
+            QElapsedTimer t;
+            t.start();
+            const auto materialized = store.toList();
+            list.samplesMs.append(double(t.nsecsElapsed()) / 1e6);
+        }
+        add(std::move(list));
+    }
+
+    QList<int> m_sizes;
+    int m_repeat;
+    int m_latencyMs;
+    int m_detailSample;
+    QList<Result> m_results;
+};
+
+bool writeJson(const QString& path, const QList<Result>& results)
+{
+    QJsonArray arr;
+    for (const auto& r : results)
+    {
+        QJsonArray samples;
+        for (double s : r.samplesMs) samples.append(s);
+        arr.append(QJsonObject{
+            {"name", r.name},
+            {"size", r.size},
+            {"medianMs", median(r.samplesMs)},
+            {"p95Ms", percentile(r.samplesMs, 0.95)},
+            {"samplesMs", samples},
+            {"note", r.note},
+        });
+    }
+    QFile f(path);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    f.write(QJsonDocument(QJsonObject{{"results", arr}}).toJson());
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("JiraExplorerBench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Offline benchmarks for JiraExplorerQt against a mock Jira server.");
+    parser.addHelpOption();
+    const QCommandLineOption sizesOpt("sizes", "Comma separated issue counts.", "list", "1000,10000,100000");
+    const QCommandLineOption repeatOpt("repeat", "Iterations per measurement.", "n", "5");
+    const QCommandLineOption latencyOpt("latency", "Mock server latency per response.", "ms", "0");
+    const QCommandLineOption detailsOpt("details", "Issues loaded in the detail benchmark.", "n", "200");
+    const QCommandLineOption jsonOpt("json", "Also write results to this file.", "path");
+    parser.addOptions({sizesOpt, repeatOpt, latencyOpt, detailsOpt, jsonOpt});
+    parser.process(app);
+
+    QList<int> sizes;
+    for (const auto& s : parser.value(sizesOpt).split(',', Qt::SkipEmptyParts))
+        if (const int n = s.trimmed().toInt(); n > 0) sizes.append(n);
+
+    // Paths given on the command line are relative to where we were started, not to the
+    // temporary directories the benchmarks switch into.
+    const QString jsonPath = parser.isSet(jsonOpt) ? QDir::current().absoluteFilePath(parser.value(jsonOpt)) : QString();
+    const QString startDir = QDir::currentPath();
+
+    Bench bench(sizes, std::max(1, parser.value(repeatOpt).toInt()), std::max(0, parser.value(latencyOpt).toInt()),
+                std::max(1, parser.value(detailsOpt).toInt()));
+    bench.run();
+    QDir::setCurrent(startDir);
+
+    if (!jsonPath.isEmpty() && !writeJson(jsonPath, bench.results()))
+    {
+        QTextStream(stderr) << "could not write " << jsonPath << Qt::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,512 @@
+#include "mockjiraserver.h"
+
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QPointer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QUrlQuery>
+
+#include <algorithm>
+
+static constexpr auto kSprintField = "customfield_10020";
+static constexpr auto kStoryPointsField = "customfield_10016";
+static constexpr auto kKeyPrefix = "BENCH-";
+
+static const char* const kWords[] = {
+    "deploy", "cache", "sprint", "review", "latency", "backlog", "customer", "release", "invoice", "search",
+    "timeout", "rollback", "schema", "token", "widget", "export", "import", "report", "queue", "session",
+};
+static constexpr int kWordCount = int(sizeof(kWords) / sizeof(kWords[0]));
+
+static QString words(int count, int seed)
+{
+    QString s;
+    for (int i = 0; i < count; ++i)
+    {
+        if (i) s += ' ';
+        s += QLatin1String(kWords[(seed * 7 + i * 13) % kWordCount]);
+    }
+    return s;
+}
+
+static QString jiraTimestamp(const QDateTime& dt)
+{
+    return dt.toUTC().toString("yyyy-MM-ddTHH:mm:ss.zzz") + "+0000";
+}
+
+static QDateTime baseTime()
+{
+    return QDateTime(QDate(2024, 1, 1), QTime(12, 0), Qt::UTC);
+}
+
+static QJsonObject text(const QString& s)
+{
+    return QJsonObject{{"type", "text"}, {"text", s}};
+}
+
+static QJsonObject node(const char* type, const QJsonArray& content)
+{
+    return QJsonObject{{"type", type}, {"content", content}};
+}
+
+static QJsonObject paragraph(const QJsonArray& content)
+{
+    return node("paragraph", content);
+}
+
+static QJsonArray transitionList()
+{
+    return QJsonArray{
+        QJsonObject{{"id", "11"}, {"name", "To Do"}},
+        QJsonObject{{"id", "21"}, {"name", "In Progress"}},
+        QJsonObject{{"id", "31"}, {"name", "In Review"}},
+        QJsonObject{{"id", "41"}, {"name", "Done"}},
+    };
+}
+
+static QByteArray json(const QJsonObject& o)
+{
+    return QJsonDocument(o).toJson(QJsonDocument::Compact);
+}
+
+MockJiraServer::MockJiraServer(const Options& options, QObject* parent)
+    : QObject(parent),
+      m_options(options)
+{
+    connect(&m_server, &QTcpServer::newConnection, this, &MockJiraServer::onNewConnection);
+}
+
+bool MockJiraServer::listen()
+{
+    return m_server.listen(QHostAddress::LocalHost, 0);
+}
+
+QString MockJiraServer::baseUrl() const
+{
+    return QString("http://127.0.0.1:%1").arg(m_server.serverPort());
+}
+
+void MockJiraServer::resetCounters()
+{
+    m_requests = 0;
+    m_bytesSent = 0;
+}
+
+QString MockJiraServer::issueKey(int index)
+{
+    return kKeyPrefix + QString::number(index + 1);
+}
+
+int MockJiraServer::issueIndex(const QString& key) const
+{
+    if (!key.startsWith(QLatin1String(kKeyPrefix)))
+        return -1;
+    bool ok = false;
+    const int n = key.mid(int(qstrlen(kKeyPrefix))).toInt(&ok);
+    return ok && n >= 1 && n <= m_options.issueCount ? n - 1 : -1;
+}
+
+QJsonObject MockJiraServer::descriptionAdf(int blocks, int seed)
+{
+    QJsonArray content;
+    for (int b = 0; b < blocks; ++b)
+    {
+        const int s = seed * 31 + b;
+        switch (b % 6)
+        {
+        case 0:
+        {
+            QJsonObject bold = text(words(2, s + 1));
+            bold.insert("marks", QJsonArray{QJsonObject{{"type", "strong"}}});
+            content.append(paragraph({
+                text(words(12, s) + " "),
+                bold,
+                text(" cc "),
+                QJsonObject{{"type", "mention"}, {"attrs", QJsonObject{{"id", "acc-" + QString::number(s % 97)}, {"text", "@Dev " + QString::number(s % 97)}}}},
+                QJsonObject{{"type", "hardBreak"}},
+                text(words(8, s + 2)),
+            }));
+            break;
+        }
+        case 1:
+        {
+            QJsonObject heading = node("heading", {text(words(4, s))});
+            heading.insert("attrs", QJsonObject{{"level", 1 + s % 3}});
+            content.append(heading);
+            break;
+        }
+        case 2:
+        {
+            QJsonArray items;
+            for (int i = 0; i < 4; ++i)
+            {
+                QJsonArray item{paragraph({text(words(6, s + i))})};
+                if (i == 1)
+                    item.append(node("bulletList", {node("listItem", {paragraph({text(words(3, s + 9))})})}));
+                items.append(node("listItem", item));
+            }
+            content.append(node(b % 12 == 2 ? "bulletList" : "orderedList", items));
+            break;
+        }
+        case 3:
+        {
+            QJsonObject code = node("codeBlock", {text("if (retries > 3)\n    " + words(3, s).replace(' ', '_') + "();\nreturn;")});
+            code.insert("attrs", QJsonObject{{"language", "cpp"}});
+            content.append(code);
+            break;
+        }
+        case 4:
+        {
+            QJsonArray rows;
+            for (int r = 0; r < 3; ++r)
+            {
+                QJsonArray cells;
+                for (int c = 0; c < 3; ++c)
+                    cells.append(node(r == 0 ? "tableHeader" : "tableCell", {paragraph({text(words(2, s + r * 3 + c))})}));
+                rows.append(node("tableRow", cells));
+            }
+            content.append(node("table", rows));
+            break;
+        }
+        default:
+            content.append(paragraph({text(words(20, s))}));
+            break;
+        }
+    }
+
+    QJsonObject doc = node("doc", content);
+    doc.insert("version", 1);
+    return doc;
+}
+
+QJsonObject MockJiraServer::sprintJson(int sprintId) const
+{
+    // Sprint ids are board * 100 + n; the last sprint of every board is active.
+    const int n = sprintId % 100;
+    const bool active = n == m_options.sprintsPerBoard - 1;
+    const auto start = baseTime().addDays(-14 * (m_options.sprintsPerBoard - n));
+    return QJsonObject{
+        {"id", sprintId},
+        {"name", QString("Board %1 Sprint %2").arg(sprintId / 100).arg(n + 1)},
+        {"state", active ? "active" : "closed"},
+        {"startDate", jiraTimestamp(start)},
+        {"endDate", jiraTimestamp(start.addDays(14))},
+    };
+}
+
+QJsonObject MockJiraServer::searchIssueJson(int index) const
+{
+    QJsonObject fields{
+        {"summary", words(8, index)},
+        {"status", QJsonObject{{"name", index % 3 == 0 ? "In Progress" : index % 3 == 1 ? "To Do" : "In Review"}}},
+        {"updated", jiraTimestamp(baseTime().addSecs(-60LL * index))},
+    };
+    // Every seventh issue is outside any sprint.
+    const int sprints = std::max(1, m_options.boardCount * m_options.sprintsPerBoard);
+    if (index % 7 != 0)
+    {
+        const int slot = index % sprints;
+        const int sprintId = (1 + slot / std::max(1, m_options.sprintsPerBoard)) * 100 + slot % std::max(1, m_options.sprintsPerBoard);
+        fields.insert(kSprintField, QJsonArray{sprintJson(sprintId)});
+    }
+    return QJsonObject{{"id", QString::number(10000 + index)}, {"key", issueKey(index)}, {"fields", fields}};
+}
+
+QJsonObject MockJiraServer::commentJson(int issueIndex, int commentIndex) const
+{
+    return QJsonObject{
+        {"id", QString::number(issueIndex * 1000 + commentIndex)},
+        {"author", QJsonObject{{"displayName", "Dev " + QString::number((issueIndex + commentIndex) % 17)}}},
+        {"created", jiraTimestamp(baseTime().addSecs(-3600LL * (commentIndex + 1)))},
+        {"body", descriptionAdf(2, issueIndex * 131 + commentIndex)},
+    };
+}
+
+void MockJiraServer::onNewConnection()
+{
+    while (QTcpSocket* socket = m_server.nextPendingConnection())
+    {
+        m_connections.insert(socket, Connection{});
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+            m_connections[socket].buffer += socket->readAll();
+            processBuffer(socket);
+        });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            m_connections.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void MockJiraServer::processBuffer(QTcpSocket* socket)
+{
+    // One request at a time per connection; keep-alive requests queue in the buffer.
+    auto it = m_connections.find(socket);
+    if (it == m_connections.end() || it->busy)
+        return;
+
+    QByteArray& buffer = it->buffer;
+    const qsizetype headerEnd = buffer.indexOf("\r\n\r\n");
+    if (headerEnd < 0)
+        return;
+
+    Request request;
+    const auto lines = buffer.left(headerEnd).split('\n');
+    const auto requestLine = lines.value(0).trimmed().split(' ');
+    if (requestLine.size() < 2)
+    {
+        socket->disconnectFromHost();
+        return;
+    }
+    request.method = requestLine[0];
+    request.url = QUrl::fromEncoded(requestLine[1]);
+    for (qsizetype i = 1; i < lines.size(); ++i)
+    {
+        const qsizetype colon = lines[i].indexOf(':');
+        if (colon > 0)
+            request.headers.insert(lines[i].left(colon).trimmed().toLower(), lines[i].mid(colon + 1).trimmed());
+    }
+
+    const qsizetype length = request.headers.value("content-length").toLongLong();
+    if (buffer.size() < headerEnd + 4 + length)
+        return;
+    request.body = buffer.mid(headerEnd + 4, length);
+    buffer.remove(0, headerEnd + 4 + length);
+    ++m_requests;
+
+    Response response = route(request);
+    if (!response.etag.isEmpty() && request.headers.value("if-none-match") == response.etag)
+    {
+        response.status = 304;
+        response.body.clear();
+    }
+
+    it->busy = true;
+    QPointer<QTcpSocket> guard(socket);
+    const auto send = [this, guard, response]() {
+        if (!guard)
+            return;
+        write(guard, response);
+        auto it = m_connections.find(guard);
+        if (it == m_connections.end())
+            return;
+        it->busy = false;
+        processBuffer(guard);
+    };
+    if (m_options.latencyMs > 0)
+        QTimer::singleShot(m_options.latencyMs, socket, send);
+    else
+        send();
+}
+
+void MockJiraServer::write(QTcpSocket* socket, const Response& response)
+{
+    static const QHash<int, QByteArray> reasons{
+        {200, "OK"}, {201, "Created"}, {204, "No Content"}, {304, "Not Modified"}, {400, "Bad Request"}, {404, "Not Found"},
+    };
+
+    QByteArray out = "HTTP/1.1 " + QByteArray::number(response.status) + ' ' + reasons.value(response.status, "Unknown") + "\r\n";
+    if (response.status != 204 && response.status != 304)
+        out += "Content-Type: application/json;charset=UTF-8\r\n";
+    if (!response.etag.isEmpty())
+        out += "ETag: " + response.etag + "\r\nCache-Control: no-cache\r\n";
+    out += "Content-Length: " + QByteArray::number(response.body.size()) + "\r\n";
+    out += "Connection: keep-alive\r\n\r\n";
+    out += response.body;
+
+    m_bytesSent += quint64(out.size());
+    socket->write(out);
+}
+
+MockJiraServer::Response MockJiraServer::route(const Request& request) const
+{
+    const QString path = request.url.path();
+    const auto parts = path.split('/', Qt::SkipEmptyParts);
+    const bool get = request.method == "GET";
+
+    // /rest/api/3/...
+    if (parts.size() >= 4 && parts[0] == "rest" && parts[1] == "api")
+    {
+        const auto& resource = parts[3];
+        if (resource == "field" && get)
+        {
+            return Response{200, QJsonDocument(QJsonArray{
+                QJsonObject{{"id", "summary"}, {"name", "Summary"}},
+                QJsonObject{{"id", kSprintField}, {"name", "Sprint"}},
+                QJsonObject{{"id", kStoryPointsField}, {"name", "Story Points"}},
+            }).toJson(QJsonDocument::Compact), "\"fields-1\""};
+        }
+        if (resource == "search" && parts.value(4) == "jql" && request.method == "POST")
+            return searchJql(request);
+        if (resource == "user" && request.method == "POST")
+            return Response{200, "{\"values\":[{\"accountId\":\"acc-1\",\"displayName\":\"Dev 1\"}]}"};
+        if (resource == "issue" && parts.size() >= 5)
+        {
+            const int index = issueIndex(parts[4]);
+            if (index < 0)
+                return Response{404, "{\"errorMessages\":[\"Issue does not exist\"]}"};
+            const auto sub = parts.value(5);
+            if (sub.isEmpty())
+                return get ? issue(index) : Response{204, {}};
+            if (sub == "comment")
+            {
+                if (get)
+                    return comments(request, index);
+                return Response{request.method == "POST" ? 201 : 200, json(commentJson(index, m_options.commentsPerIssue))};
+            }
+            if (sub == "transitions")
+                return get ? transitions() : Response{204, {}};
+            if (sub == "assignee")
+                return Response{204, {}};
+        }
+    }
+
+    // /rest/agile/1.0/...
+    if (parts.size() >= 4 && parts[0] == "rest" && parts[1] == "agile" && get)
+    {
+        if (parts[3] == "board" && parts.size() == 4)
+            return boards(request);
+        if (parts[3] == "board" && parts.value(5) == "sprint")
+            return boardSprints(request, parts[4].toInt());
+        if (parts[3] == "sprint" && parts.value(5) == "issue")
+            return sprintIssues(request, parts[4].toInt());
+    }
+
+    return Response{404, "{\"errorMessages\":[\"Not found\"]}"};
+}
+
+MockJiraServer::Response MockJiraServer::searchJql(const Request& request) const
+{
+    const auto body = QJsonDocument::fromJson(request.body).object();
+    const auto fields = body.value("fields").toArray();
+    const bool keysOnly = fields.size() == 1 && fields.first().toString() == "key";
+
+    const int cap = keysOnly ? m_options.keySearchPageSize : m_options.searchPageSize;
+    const int pageSize = std::clamp(body.value("maxResults").toInt(50), 1, cap);
+    const int start = std::max(0, body.value("nextPageToken").toString().toInt());
+    const int end = std::min(m_options.issueCount, start + pageSize);
+
+    QJsonArray issues;
+    for (int i = start; i < end; ++i)
+    {
+        if (keysOnly)
+            issues.append(QJsonObject{{"id", QString::number(10000 + i)}, {"key", issueKey(i)}});
+        else
+            issues.append(searchIssueJson(i));
+    }
+
+    QJsonObject root{{"issues", issues}, {"isLast", end >= m_options.issueCount}};
+    if (end < m_options.issueCount)
+        root.insert("nextPageToken", QString::number(end));
+    return Response{200, json(root)};
+}
+
+MockJiraServer::Response MockJiraServer::issue(int index) const
+{
+    auto fields = searchIssueJson(index).value("fields").toObject();
+    fields.insert("description", descriptionAdf(m_options.descriptionBlocks, index));
+    fields.insert("assignee", QJsonObject{{"displayName", "Dev " + QString::number(index % 17)}, {"accountId", "acc-" + QString::number(index % 17)}});
+    fields.insert("duedate", baseTime().date().addDays(index % 60).toString(Qt::ISODate));
+    fields.insert(kStoryPointsField, double(1 + index % 8));
+
+    // Jira embeds the first page of comments in the issue.
+    const int embedded = std::min(m_options.commentsPerIssue, 20);
+    QJsonArray commentList;
+    for (int c = 0; c < embedded; ++c)
+        commentList.append(commentJson(index, c));
+    fields.insert("comment", QJsonObject{{"comments", commentList}, {"startAt", 0}, {"maxResults", embedded}, {"total", m_options.commentsPerIssue}});
+
+    QJsonArray histories;
+    for (int h = 0; h < m_options.historyEntries; ++h)
+    {
+        histories.append(QJsonObject{
+            {"id", QString::number(index * 1000 + h)},
+            {"author", QJsonObject{{"displayName", "Dev " + QString::number((index + h) % 17)}}},
+            {"created", jiraTimestamp(baseTime().addSecs(-1800LL * (h + 1)))},
+            {"items", QJsonArray{QJsonObject{{"field", "status"}, {"fromString", "To Do"}, {"toString", "In Progress"}}}},
+        });
+    }
+
+    const QJsonObject root{
+        {"id", QString::number(10000 + index)},
+        {"key", issueKey(index)},
+        {"fields", fields},
+        {"changelog", QJsonObject{{"startAt", 0}, {"maxResults", histories.size()}, {"total", histories.size()}, {"histories", histories}}},
+        {"transitions", transitionList()},
+    };
+    return Response{200, json(root), "\"" + issueKey(index).toUtf8() + "-1\""};
+}
+
+MockJiraServer::Response MockJiraServer::comments(const Request& request, int index) const
+{
+    const QUrlQuery q(request.url);
+    const int startAt = std::max(0, q.queryItemValue("startAt").toInt());
+    const int maxResults = std::clamp(q.queryItemValue("maxResults").toInt(), 1, 100);
+    const int end = std::min(m_options.commentsPerIssue, startAt + maxResults);
+
+    QJsonArray list;
+    for (int c = startAt; c < end; ++c)
+        list.append(commentJson(index, c));
+    const QJsonObject root{{"startAt", startAt}, {"maxResults", maxResults}, {"total", m_options.commentsPerIssue}, {"comments", list}};
+    return Response{200, json(root), "\"" + issueKey(index).toUtf8() + "-c" + QByteArray::number(startAt) + "-1\""};
+}
+
+MockJiraServer::Response MockJiraServer::transitions() const
+{
+    return Response{200, json(QJsonObject{{"transitions", transitionList()}})};
+}
+
+MockJiraServer::Response MockJiraServer::boards(const Request& request) const
+{
+    const QUrlQuery q(request.url);
+    const int startAt = std::max(0, q.queryItemValue("startAt").toInt());
+    const int maxResults = std::clamp(q.queryItemValue("maxResults").toInt(), 1, 50);
+    const int end = std::min(m_options.boardCount, startAt + maxResults);
+
+    QJsonArray values;
+    for (int b = startAt; b < end; ++b)
+        values.append(QJsonObject{{"id", b + 1}, {"name", QString("Board %1").arg(b + 1)}, {"type", "scrum"}});
+    const QJsonObject root{{"startAt", startAt}, {"maxResults", maxResults}, {"total", m_options.boardCount}, {"isLast", end >= m_options.boardCount}, {"values", values}};
+    return Response{200, json(root)};
+}
+
+MockJiraServer::Response MockJiraServer::boardSprints(const Request& request, int boardId) const
+{
+    if (boardId < 1 || boardId > m_options.boardCount)
+        return Response{404, "{\"errorMessages\":[\"Board does not exist\"]}"};
+
+    const QUrlQuery q(request.url);
+    const QString state = q.queryItemValue("state");
+    QJsonArray values;
+    for (int n = 0; n < m_options.sprintsPerBoard; ++n)
+    {
+        const auto sprint = sprintJson(boardId * 100 + n);
+        if (state.isEmpty() || state.split(',').contains(sprint.value("state").toString()))
+            values.append(sprint);
+    }
+    const QJsonObject root{{"startAt", 0}, {"maxResults", 50}, {"isLast", true}, {"values", values}};
+    return Response{200, json(root)};
+}
+
+MockJiraServer::Response MockJiraServer::sprintIssues(const Request& request, int sprintId) const
+{
+    const QUrlQuery q(request.url);
+    const int startAt = std::max(0, q.queryItemValue("startAt").toInt());
+    const int maxResults = std::clamp(q.queryItemValue("maxResults").toInt(), 1, 100);
+    const int total = std::min(m_options.sprintIssueCount, m_options.issueCount);
+    const int end = std::min(total, startAt + maxResults);
+    const auto sprint = sprintJson(sprintId);
+
+    QJsonArray issues;
+    for (int i = startAt; i < end; ++i)
+    {
+        auto fields = searchIssueJson(i).value("fields").toObject();
+        fields.remove(kSprintField);
+        fields.insert("sprint", sprint);
+        issues.append(QJsonObject{{"id", QString::number(10000 + i)}, {"key", issueKey(i)}, {"fields", fields}});
+    }
+    const QJsonObject root{{"startAt", startAt}, {"maxResults", maxResults}, {"total", total}, {"issues", issues}};
+    return Response{200, json(root)};
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QJsonObject>
+#include <QObject>
+#include <QTcpServer>
+#include <QUrl>
+
+class QTcpSocket;
+
+// In-process stand-in for the Jira Cloud REST API, serving deterministic synthetic
+// data over plain HTTP/1.1 on 127.0.0.1. Covers what JiraClient calls: /field,
+// /search/jql, /issue/{key} (+ /comment, /transitions), /board, /board/{id}/sprint and
+// /sprint/{id}/issue. Issue reads carry an ETag and answer If-None-Match with 304.
+class MockJiraServer : public QObject
+{
+    Q_OBJECT
+public:
+    struct Options
+    {
+        int issueCount{1000};
+        int commentsPerIssue{5};
+        int descriptionBlocks{8};
+        int historyEntries{10};
+        int boardCount{4};
+        int sprintsPerBoard{3};
+        int sprintIssueCount{50};
+        // Page cap for /search/jql; key-only searches get the larger one, as on Jira Cloud.
+        int searchPageSize{100};
+        int keySearchPageSize{5000};
+        // Added before every response is written.
+        int latencyMs{0};
+    };
+
+    explicit MockJiraServer(const Options& options, QObject* parent = nullptr);
+
+    bool listen();
+    QString baseUrl() const;
+
+    const Options& options() const { return m_options; }
+    void setLatency(int ms) { m_options.latencyMs = ms; }
+
+    quint64 requestCount() const { return m_requests; }
+    quint64 bytesSent() const { return m_bytesSent; }
+    void resetCounters();
+
+    static QString issueKey(int index);
+    // Mix of paragraphs (marks, mentions, hard breaks), headings, nested lists, code
+    // blocks and tables; `seed` varies the text so documents do not compress to nothing.
+    static QJsonObject descriptionAdf(int blocks, int seed);
+
+private:
+    struct Request
+    {
+        QByteArray method;
+        QUrl url;
+        QHash<QByteArray, QByteArray> headers; // lower-cased names
+        QByteArray body;
+    };
+    struct Response
+    {
+        int status{200};
+        QByteArray body;
+        QByteArray etag;
+    };
+    struct Connection
+    {
+        QByteArray buffer;
+        bool busy{false};
+    };
+
+    void onNewConnection();
+    void processBuffer(QTcpSocket* socket);
+    void write(QTcpSocket* socket, const Response& response);
+
+    Response route(const Request& request) const;
+    Response searchJql(const Request& request) const;
+    Response issue(int index) const;
+    Response comments(const Request& request, int index) const;
+    Response transitions() const;
+    Response boards(const Request& request) const;
+    Response boardSprints(const Request& request, int boardId) const;
+    Response sprintIssues(const Request& request, int sprintId) const;
+
+    int issueIndex(const QString& key) const;
+    QJsonObject sprintJson(int sprintId) const;
+    QJsonObject searchIssueJson(int index) const;
+    QJsonObject commentJson(int issueIndex, int commentIndex) const;
+
+    Options m_options;
+    QTcpServer m_server;
+    QHash<QTcpSocket*, Connection> m_connections;
+    quint64 m_requests{0};
+    quint64 m_bytesSent{0};
+};
@@ -0,0 +1,207 @@
+#include "adf.h"
+
+#include <QJsonArray>
+
+#include <algorithm>
+#include <vector>
+
+QJsonObject Adf::fromPlainText(const QString& plainText)
+{
+    const QString safe = plainText;
+    const auto parts = safe.split('\n');
+
+    QJsonArray content;
+    for (const auto& p : parts)
+    {
+        QJsonObject textNode;
+        textNode.insert("type", "text");
+        textNode.insert("text", p);
+
+        QJsonArray paraContent;
+        paraContent.append(textNode);
+
+        QJsonObject paragraph;
+        paragraph.insert("type", "paragraph");
+        paragraph.insert("content", paraContent);
+
+        content.append(paragraph);
+    }
+
+    QJsonObject doc;
+    doc.insert("version", 1);
+    doc.insert("type", "doc");
+    doc.insert("content", content);
+    return doc;
+}
+
+namespace {
+
+// How a container's children are laid out relative to each other.
+enum class Layout
+{
+    Inline, // paragraph, heading, codeBlock: children run together
+    Blocks, // doc, listItem, blockquote, ...: one child per line
+    List,   // bulletList/orderedList: one item per line, items get a marker
+    Row,    // tableRow: cells joined by " | "
+    Cell,   // tableCell/tableHeader: blocks joined by spaces, no line breaks
+};
+
+struct Frame
+{
+    QJsonArray children;
+    qsizetype next{0};
+    Layout layout{Layout::Blocks};
+    bool inCell{false};
+    bool ordered{false};
+    int depth{0};   // list nesting, for item indentation
+    int ordinal{1}; // next number in an ordered list
+};
+
+void appendSeparator(QString& out, const Frame& f)
+{
+    switch (f.layout)
+    {
+    case Layout::Inline: break;
+    case Layout::Cell: out += QLatin1Char(' '); break;
+    case Layout::Row: out += QLatin1String(" | "); break;
+    case Layout::Blocks:
+    case Layout::List: out += f.inCell ? QLatin1Char(' ') : QLatin1Char('\n'); break;
+    }
+}
+
+Layout layoutFor(QStringView type, Layout parent)
+{
+    if (type == QLatin1String("paragraph") || type == QLatin1String("heading") || type == QLatin1String("codeBlock"))
+        return Layout::Inline;
+    if (type == QLatin1String("bulletList") || type == QLatin1String("orderedList"))
+        return Layout::List;
+    if (type == QLatin1String("tableRow"))
+        return Layout::Row;
+    if (type == QLatin1String("tableCell") || type == QLatin1String("tableHeader"))
+        return Layout::Cell;
+    // Unknown nodes inside running text (e.g. inline marks wrappers) must not add breaks.
+    if (parent == Layout::Inline)
+        return Layout::Inline;
+    return Layout::Blocks;
+}
+
+} // namespace
+
+QString Adf::toPlainText(const QJsonValue& adf)
+{
+    // Iterative walk over an explicit stack, appending into one buffer. Paragraphs and
+    // other blocks go on their own lines (hardBreak starts a new one), list items get
+    // "- " / "1. " markers indented by depth, table rows become "a | b | c" lines and
+    // mentions/emoji/cards contribute their display text.
+    if (adf.isNull() || adf.isUndefined())
+        return QString();
+
+    std::vector<Frame> stack;
+    stack.reserve(16);
+    {
+        Frame root;
+        root.children = adf.isArray() ? adf.toArray() : QJsonArray{adf};
+        stack.push_back(std::move(root));
+    }
+
+    QString out;
+    // Plain text is usually a fraction of the JSON; most documents never regrow.
+    const auto top = adf.toObject().value(QLatin1String("content"));
+    out.reserve(std::max<qsizetype>(256, (top.isArray() ? top.toArray().size() : 1) * 96));
+
+    while (!stack.empty())
+    {
+        Frame& f = stack.back();
+        if (f.next >= f.children.size())
+        {
+            stack.pop_back();
+            continue;
+        }
+
+        const QJsonValue child = f.children.at(f.next);
+        if (f.next > 0)
+            appendSeparator(out, f);
+        ++f.next;
+
+        if (!child.isObject())
+            continue;
+
+        const QJsonObject node = child.toObject();
+        const QString type = node.value(QLatin1String("type")).toString();
+
+        if (type == QLatin1String("text"))
+        {
+            out += node.value(QLatin1String("text")).toString();
+            continue;
+        }
+        if (type == QLatin1String("hardBreak"))
+        {
+            out += f.inCell ? QLatin1Char(' ') : QLatin1Char('\n');
+            continue;
+        }
+        if (type == QLatin1String("mention") || type == QLatin1String("emoji") || type == QLatin1String("status"))
+        {
+            const auto attrs = node.value(QLatin1String("attrs")).toObject();
+            QString display = attrs.value(QLatin1String("text")).toString();
+            if (display.isEmpty()) display = attrs.value(QLatin1String("shortName")).toString();
+            out += display;
+            continue;
+        }
+        if (type == QLatin1String("inlineCard") || type == QLatin1String("blockCard") || type == QLatin1String("embedCard"))
+        {
+            out += node.value(QLatin1String("attrs")).toObject().value(QLatin1String("url")).toString();
+            continue;
+        }
+        if (type == QLatin1String("rule"))
+        {
+            out += QLatin1String("---");
+            continue;
+        }
+
+        const QJsonValue content = node.value(QLatin1String("content"));
+        if (!content.isArray())
+            continue; // media and other leaves without text
+
+        Frame next;
+        next.children = content.toArray();
+        next.inCell = f.inCell;
+        next.depth = f.depth;
+
+        if (type == QLatin1String("listItem") && f.layout == Layout::List)
+        {
+            // Marker first; the item's blocks follow it (nested lists on later lines).
+            if (!f.inCell)
+                out += QString(2 * (f.depth - 1), QLatin1Char(' '));
+            if (f.ordered)
+                out += QString::number(f.ordinal++) + QLatin1String(". ");
+            else
+                out += QLatin1String("- ");
+            next.layout = Layout::Blocks;
+        }
+        else
+        {
+            next.layout = layoutFor(type, f.layout);
+            if (next.layout == Layout::List)
+            {
+                next.depth = f.depth + 1;
+                next.ordered = type == QLatin1String("orderedList");
+                next.ordinal = node.value(QLatin1String("attrs")).toObject().value(QLatin1String("order")).toInt(1);
+            }
+            else if (next.layout == Layout::Cell)
+            {
+                next.inCell = true;
+            }
+        }
+
+        stack.push_back(std::move(next)); // invalidates f
+    }
+
+    // Same trimming as before: no leading/trailing whitespace or blank lines.
+    qsizetype end = out.size();
+    while (end > 0 && out.at(end - 1).isSpace()) --end;
+    out.truncate(end);
+    qsizetype begin = 0;
+    while (begin < out.size() && out.at(begin).isSpace()) ++begin;
+    if (begin > 0) out.remove(0, begin);
+    return out;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+
+// Atlassian Document Format (ADF): the JSON rich-text format Jira uses for
+// descriptions and comments.
+class Adf
+{
+public:
+    // One paragraph per line.
+    static QJsonObject fromPlainText(const QString& plainText);
+    static QString toPlainText(const QJsonValue& adf);
+};
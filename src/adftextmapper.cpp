@@ -0,0 +1,1081 @@
+#include "adftextmapper.h"
+#include "adf.h"
+
+#include <QColor>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFont>
+#include <QHash>
+#include <QJsonDocument>
+#include <QTextBlock>
+#include <QTextDocument>
+#include <QTextFrame>
+#include <QTextList>
+#include <QTextTable>
+#include <QTimer>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Slice budget for progressive loading; the first slice renders inside load().
+constexpr qint64 kSliceMs = 12;
+
+enum Property : int
+{
+    // block
+    kCodeBlockProperty = QTextFormat::UserProperty + 1,
+    kCodeLanguageProperty,
+    kQuoteProperty,
+    kRuleProperty,
+    kPreservedProperty,     // compact JSON of a node shown as text only
+    kPreservedTextProperty, // the text it was shown as
+    kContinuationProperty,  // later block of a list item; list depth
+    // table / cell
+    kTableAttrsProperty,
+    kCellAttrsProperty,
+    kHeaderCellProperty,
+    // char
+    kInlineCodeProperty,
+    kMentionIdProperty,
+    kInlineNodeProperty, // compact JSON of an emoji/status/date/card
+    kInlineTextProperty, // the text it was shown as
+    kTextColorProperty,
+    // list
+    kListStartProperty,
+};
+
+const QColor kLinkColor(0x00, 0x52, 0xCC);
+const QColor kMutedColor(0x6B, 0x77, 0x8C);
+
+class AdfBlockData : public QTextBlockUserData
+{
+public:
+    AdfBlockData(int node, bool structural) : node(node), structural(structural) {}
+
+    int node;
+    // Empty block the editor needs around a table; dropped on export while empty.
+    bool structural;
+    size_t fingerprint{0};
+};
+
+AdfBlockData* dataOf(const QTextBlock& block)
+{
+    return static_cast<AdfBlockData*>(block.userData());
+}
+
+// Changes with the text and with any block, list or character format change.
+size_t fingerprint(const QTextBlock& block)
+{
+    size_t h = qHashMulti(0, block.text(), block.blockFormatIndex(), block.charFormatIndex());
+    for (auto it = block.begin(); !it.atEnd(); ++it)
+        h = qHashMulti(h, it.fragment().length(), it.fragment().charFormatIndex());
+    return h;
+}
+
+QString compact(const QJsonObject& o)
+{
+    return QString::fromUtf8(QJsonDocument(o).toJson(QJsonDocument::Compact));
+}
+
+QJsonObject parseObject(const QString& json)
+{
+    return QJsonDocument::fromJson(json.toUtf8()).object();
+}
+
+QString typeOf(const QJsonValue& v)
+{
+    return v.toObject().value(QLatin1String("type")).toString();
+}
+
+bool isList(const QString& type)
+{
+    return type == QLatin1String("bulletList") || type == QLatin1String("orderedList");
+}
+
+void applyMarks(const QJsonArray& marks, QTextCharFormat& cf)
+{
+    for (const auto& m : marks)
+    {
+        const auto mark = m.toObject();
+        const auto type = mark.value(QLatin1String("type")).toString();
+        const auto attrs = mark.value(QLatin1String("attrs")).toObject();
+        if (type == QLatin1String("strong"))
+            cf.setFontWeight(QFont::Bold);
+        else if (type == QLatin1String("em"))
+            cf.setFontItalic(true);
+        else if (type == QLatin1String("strike"))
+            cf.setFontStrikeOut(true);
+        else if (type == QLatin1String("underline"))
+            cf.setFontUnderline(true);
+        else if (type == QLatin1String("code"))
+        {
+            cf.setFontFixedPitch(true);
+            cf.setFontFamilies({QStringLiteral("monospace")});
+            cf.setProperty(kInlineCodeProperty, true);
+        }
+        else if (type == QLatin1String("link"))
+        {
+            cf.setAnchor(true);
+            cf.setAnchorHref(attrs.value(QLatin1String("href")).toString());
+            cf.setForeground(kLinkColor);
+        }
+        else if (type == QLatin1String("subsup"))
+        {
+            cf.setVerticalAlignment(attrs.value(QLatin1String("type")).toString() == QLatin1String("sub")
+                                        ? QTextCharFormat::AlignSubScript
+                                        : QTextCharFormat::AlignSuperScript);
+        }
+        else if (type == QLatin1String("textColor"))
+        {
+            const auto color = attrs.value(QLatin1String("color")).toString();
+            cf.setForeground(QColor(color));
+            cf.setProperty(kTextColorProperty, color);
+        }
+    }
+}
+
+QJsonArray marksOf(const QTextCharFormat& f, bool heading)
+{
+    QJsonArray marks;
+    if (f.isAnchor() && !f.anchorHref().isEmpty())
+        marks.append(QJsonObject{{"type", "link"}, {"attrs", QJsonObject{{"href", f.anchorHref()}}}});
+
+    // ADF only allows links next to a code mark.
+    if (f.property(kInlineCodeProperty).toBool() || f.fontFixedPitch())
+    {
+        marks.append(QJsonObject{{"type", "code"}});
+        return marks;
+    }
+
+    // Heading text is bold by style, not by markup.
+    if (!heading && f.fontWeight() >= QFont::DemiBold)
+        marks.append(QJsonObject{{"type", "strong"}});
+    if (f.fontItalic())
+        marks.append(QJsonObject{{"type", "em"}});
+    if (f.fontStrikeOut())
+        marks.append(QJsonObject{{"type", "strike"}});
+    if (f.fontUnderline())
+        marks.append(QJsonObject{{"type", "underline"}});
+    if (f.verticalAlignment() == QTextCharFormat::AlignSubScript || f.verticalAlignment() == QTextCharFormat::AlignSuperScript)
+    {
+        const bool sub = f.verticalAlignment() == QTextCharFormat::AlignSubScript;
+        marks.append(QJsonObject{{"type", "subsup"}, {"attrs", QJsonObject{{"type", sub ? "sub" : "sup"}}}});
+    }
+    if (f.hasProperty(kTextColorProperty))
+        marks.append(QJsonObject{{"type", "textColor"}, {"attrs", QJsonObject{{"color", f.property(kTextColorProperty).toString()}}}});
+    return marks;
+}
+
+QJsonArray inlineContent(const QTextBlock& block, bool heading, bool code)
+{
+    QJsonArray out;
+    for (auto it = block.begin(); !it.atEnd(); ++it)
+    {
+        const QTextFragment frag = it.fragment();
+        if (!frag.isValid())
+            continue;
+        const QTextCharFormat f = frag.charFormat();
+        QString text = frag.text();
+
+        if (code)
+        {
+            text.replace(QChar::LineSeparator, QLatin1Char('\n'));
+            if (!text.isEmpty())
+                out.append(QJsonObject{{"type", "text"}, {"text", text}});
+            continue;
+        }
+        if (f.hasProperty(kMentionIdProperty))
+        {
+            out.append(QJsonObject{{"type", "mention"},
+                                   {"attrs", QJsonObject{{"id", f.property(kMentionIdProperty).toString()}, {"text", text}}}});
+            continue;
+        }
+        if (f.hasProperty(kInlineNodeProperty) && text == f.property(kInlineTextProperty).toString())
+        {
+            out.append(parseObject(f.property(kInlineNodeProperty).toString()));
+            continue;
+        }
+
+        const QJsonArray marks = marksOf(f, heading);
+        const auto parts = text.split(QChar::LineSeparator);
+        for (qsizetype i = 0; i < parts.size(); ++i)
+        {
+            if (i > 0)
+                out.append(QJsonObject{{"type", "hardBreak"}});
+            if (parts[i].isEmpty())
+                continue;
+            QJsonObject node{{"type", "text"}, {"text", parts[i]}};
+            if (!marks.isEmpty())
+                node.insert("marks", marks);
+            out.append(node);
+        }
+    }
+    return out;
+}
+
+QJsonObject blockNode(const QTextBlock& block)
+{
+    const QTextBlockFormat bf = block.blockFormat();
+    if (bf.property(kRuleProperty).toBool())
+        return QJsonObject{{"type", "rule"}};
+
+    if (bf.hasProperty(kPreservedProperty) && block.text() == bf.property(kPreservedTextProperty).toString())
+        return parseObject(bf.property(kPreservedProperty).toString());
+
+    if (bf.property(kCodeBlockProperty).toBool())
+    {
+        QJsonObject node{{"type", "codeBlock"}, {"content", inlineContent(block, false, true)}};
+        const auto language = bf.property(kCodeLanguageProperty).toString();
+        if (!language.isEmpty())
+            node.insert("attrs", QJsonObject{{"language", language}});
+        return node;
+    }
+
+    if (bf.headingLevel() > 0)
+    {
+        return QJsonObject{{"type", "heading"},
+                           {"attrs", QJsonObject{{"level", std::clamp(bf.headingLevel(), 1, 6)}}},
+                           {"content", inlineContent(block, true, false)}};
+    }
+
+    return QJsonObject{{"type", "paragraph"}, {"content", inlineContent(block, false, false)}};
+}
+
+// A top-level entry of the document (or of a table cell): a block or a table.
+struct Item
+{
+    QTextBlock block;
+    QTextTable* table{nullptr};
+};
+
+QList<Item> itemsOf(QTextFrame::iterator it)
+{
+    QList<Item> items;
+    for (; !it.atEnd(); ++it)
+    {
+        if (QTextFrame* frame = it.currentFrame())
+        {
+            if (auto* table = qobject_cast<QTextTable*>(frame))
+                items.append(Item{{}, table});
+            else
+                items.append(itemsOf(frame->begin()));
+            continue;
+        }
+        if (it.currentBlock().isValid())
+            items.append(Item{it.currentBlock(), nullptr});
+    }
+    return items;
+}
+
+QList<QTextBlock> blocksOf(QTextTable* table)
+{
+    QList<QTextBlock> blocks;
+    const QTextDocument* doc = table->document();
+    for (QTextBlock b = doc->findBlock(table->firstPosition()); b.isValid() && b.position() <= table->lastPosition(); b = b.next())
+        blocks.append(b);
+    return blocks;
+}
+
+QJsonObject tableNode(QTextTable* table);
+
+// Converts a run of editor blocks/tables to ADF block nodes, regrouping list items into
+// (nested) lists and quoted blocks into blockquotes.
+// `nodeOf`, when given, receives for each item the index in the result of the top-level
+// node it ended up in.
+QJsonArray convertItems(const QList<Item>& items, QList<int>* nodeOf = nullptr)
+{
+    struct Level
+    {
+        QTextList* list;
+        int depth;
+        QJsonObject node;
+        QJsonArray items;
+        QJsonArray item;
+        bool hasItem{false};
+    };
+
+    QJsonArray out;
+    QJsonArray quote;
+    std::vector<Level> lists;
+
+    const auto flushQuote = [&]() {
+        if (quote.isEmpty()) return;
+        out.append(QJsonObject{{"type", "blockquote"}, {"content", quote}});
+        quote = QJsonArray();
+    };
+    const auto popList = [&]() {
+        Level level = std::move(lists.back());
+        lists.pop_back();
+        if (level.hasItem)
+            level.items.append(QJsonObject{{"type", "listItem"}, {"content", level.item}});
+        level.node.insert("content", level.items);
+        if (!lists.empty())
+        {
+            auto& parent = lists.back();
+            if (!parent.hasItem)
+            {
+                // A nested list needs an item to live in.
+                parent.item = QJsonArray{QJsonObject{{"type", "paragraph"}, {"content", QJsonArray()}}};
+                parent.hasItem = true;
+            }
+            parent.item.append(level.node);
+        }
+        else
+        {
+            out.append(level.node);
+        }
+    };
+    const auto closeTo = [&](int depth) {
+        while (!lists.empty() && lists.back().depth > depth)
+            popList();
+    };
+    // Called once per item after it closed whatever it does not continue: the node the
+    // item lands in is the next one appended.
+    const auto note = [&]() {
+        if (nodeOf)
+            nodeOf->append(int(out.size()));
+    };
+
+    for (const auto& entry : items)
+    {
+        if (entry.table)
+        {
+            closeTo(0);
+            flushQuote();
+            note();
+            out.append(tableNode(entry.table));
+            continue;
+        }
+
+        const QTextBlock& b = entry.block;
+        const QTextBlockFormat bf = b.blockFormat();
+        if (QTextList* list = b.textList())
+        {
+            flushQuote();
+            const int depth = std::max(1, list->format().indent());
+            closeTo(depth);
+            if (!lists.empty() && lists.back().depth == depth && lists.back().list != list)
+                popList();
+            note();
+            if (lists.empty() || lists.back().depth < depth)
+            {
+                const auto style = list->format().style();
+                const bool ordered = style == QTextListFormat::ListDecimal || style == QTextListFormat::ListLowerAlpha
+                    || style == QTextListFormat::ListUpperAlpha || style == QTextListFormat::ListLowerRoman
+                    || style == QTextListFormat::ListUpperRoman;
+                QJsonObject node{{"type", ordered ? "orderedList" : "bulletList"}};
+                if (ordered)
+                    node.insert("attrs", QJsonObject{{"order", list->format().property(kListStartProperty).toInt() > 0
+                                                                   ? list->format().property(kListStartProperty).toInt()
+                                                                   : 1}});
+                lists.push_back(Level{list, depth, node, {}, {}, false});
+            }
+            auto& level = lists.back();
+            if (level.hasItem)
+                level.items.append(QJsonObject{{"type", "listItem"}, {"content", level.item}});
+            level.item = QJsonArray{blockNode(b)};
+            level.hasItem = true;
+            continue;
+        }
+
+        if (bf.hasProperty(kContinuationProperty) && !lists.empty())
+        {
+            closeTo(bf.property(kContinuationProperty).toInt());
+            if (!lists.empty() && lists.back().hasItem)
+            {
+                note();
+                lists.back().item.append(blockNode(b));
+                continue;
+            }
+        }
+
+        closeTo(0);
+        if (bf.property(kQuoteProperty).toBool())
+        {
+            note();
+            quote.append(blockNode(b));
+            continue;
+        }
+        flushQuote();
+        note();
+        out.append(blockNode(b));
+    }
+
+    closeTo(0);
+    flushQuote();
+    return out;
+}
+
+QJsonObject tableNode(QTextTable* table)
+{
+    QJsonArray rows;
+    for (int r = 0; r < table->rows(); ++r)
+    {
+        QJsonArray cells;
+        for (int c = 0; c < table->columns(); ++c)
+        {
+            const QTextTableCell cell = table->cellAt(r, c);
+            if (!cell.isValid() || cell.row() != r || cell.column() != c)
+                continue; // covered by a span
+
+            QJsonArray content = convertItems(itemsOf(cell.begin()));
+            if (content.isEmpty())
+                content.append(QJsonObject{{"type", "paragraph"}, {"content", QJsonArray()}});
+
+            const QTextCharFormat cf = cell.format();
+            QJsonObject node{{"type", cf.property(kHeaderCellProperty).toBool() ? "tableHeader" : "tableCell"},
+                             {"attrs", parseObject(cf.property(kCellAttrsProperty).toString())},
+                             {"content", content}};
+            cells.append(node);
+        }
+        rows.append(QJsonObject{{"type", "tableRow"}, {"content", cells}});
+    }
+
+    QJsonObject attrs = parseObject(table->format().property(kTableAttrsProperty).toString());
+    return QJsonObject{{"type", "table"}, {"attrs", attrs}, {"content", rows}};
+}
+
+} // namespace
+
+AdfTextMapper::AdfTextMapper(QTextDocument* document, QObject* parent)
+    : QObject(parent),
+      m_document(document)
+{
+}
+
+void AdfTextMapper::clear()
+{
+    ++m_generation;
+    m_loading = false;
+    m_nodes.clear();
+    m_built = Built{};
+    m_pending = QJsonArray();
+    m_next = 0;
+    m_nodeIndex = -1;
+    m_cursor = QTextCursor();
+    if (m_document)
+        m_document->setUndoRedoEnabled(true);
+}
+
+void AdfTextMapper::loadPlainText(const QString& text)
+{
+    load(Adf::fromPlainText(text));
+}
+
+void AdfTextMapper::load(const QJsonObject& adf)
+{
+    clear();
+    if (!m_document)
+        return;
+
+    m_loading = true;
+    m_pending = adf.value(QLatin1String("content")).toArray();
+    m_nodes.reserve(m_pending.size());
+
+    // Loading is not an edit the user should be able to undo.
+    m_document->setUndoRedoEnabled(false);
+    m_document->clear();
+    m_cursor = QTextCursor(m_document);
+    m_reuseBlock = true;
+    renderSlice();
+}
+
+void AdfTextMapper::renderSlice()
+{
+    if (!m_document)
+    {
+        clear();
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    m_cursor.beginEditBlock();
+    while (m_next < m_pending.size() && timer.elapsed() < kSliceMs)
+    {
+        const QJsonObject node = m_pending.at(m_next++).toObject();
+        m_nodeIndex = int(m_nodes.size());
+        m_nodes.append(Node{node});
+        renderBlockNode(node, QTextBlockFormat(), 0);
+    }
+    m_cursor.endEditBlock();
+
+    if (m_next >= m_pending.size())
+    {
+        finishLoad();
+        return;
+    }
+
+    const quint64 generation = m_generation;
+    QTimer::singleShot(0, this, [this, generation]() {
+        if (generation == m_generation && m_loading)
+            renderSlice();
+    });
+}
+
+void AdfTextMapper::finishLoad()
+{
+    m_loading = false;
+    m_pending = QJsonArray();
+    m_cursor = QTextCursor();
+
+    const auto note = [this](const QTextBlock& b, int& node) {
+        auto* d = dataOf(b);
+        if (!d || d->structural || d->node < 0 || d->node >= m_nodes.size())
+            return false;
+        d->fingerprint = fingerprint(b);
+        ++m_nodes[d->node].blocks;
+        node = d->node;
+        return true;
+    };
+
+    for (const auto& item : itemsOf(m_document->rootFrame()->begin()))
+    {
+        int node = -1;
+        bool counted = false;
+        if (item.table)
+        {
+            for (const auto& b : blocksOf(item.table))
+                counted = note(b, node) || counted;
+        }
+        else
+        {
+            counted = note(item.block, node);
+        }
+        if (counted)
+            ++m_nodes[node].items;
+    }
+
+    m_document->setUndoRedoEnabled(true);
+    m_document->setModified(false);
+    emit loadFinished();
+}
+
+void AdfTextMapper::newBlock(const QTextBlockFormat& format)
+{
+    if (m_reuseBlock)
+    {
+        m_cursor.setBlockFormat(format);
+        m_cursor.setBlockCharFormat(QTextCharFormat());
+        m_reuseBlock = false;
+    }
+    else
+    {
+        m_cursor.insertBlock(format, QTextCharFormat());
+    }
+    m_cursor.block().setUserData(new AdfBlockData(m_nodeIndex, false));
+}
+
+void AdfTextMapper::renderBlockNode(const QJsonObject& node, const QTextBlockFormat& base, int listDepth)
+{
+    const QString type = node.value(QLatin1String("type")).toString();
+    const QJsonArray content = node.value(QLatin1String("content")).toArray();
+    const QJsonObject attrs = node.value(QLatin1String("attrs")).toObject();
+
+    if (type == QLatin1String("paragraph"))
+    {
+        newBlock(base);
+        renderInline(content, QTextCharFormat(), false);
+    }
+    else if (type == QLatin1String("heading"))
+    {
+        const int level = std::clamp(attrs.value(QLatin1String("level")).toInt(1), 1, 6);
+        QTextBlockFormat bf = base;
+        bf.setHeadingLevel(level);
+        newBlock(bf);
+        QTextCharFormat cf;
+        cf.setFontWeight(QFont::Bold);
+        cf.setProperty(QTextFormat::FontSizeAdjustment, std::max(0, 3 - level));
+        m_cursor.setBlockCharFormat(cf);
+        renderInline(content, cf, false);
+    }
+    else if (type == QLatin1String("codeBlock"))
+    {
+        QTextBlockFormat bf = base;
+        bf.setProperty(kCodeBlockProperty, true);
+        bf.setProperty(kCodeLanguageProperty, attrs.value(QLatin1String("language")).toString());
+        bf.setNonBreakableLines(true);
+        bf.setBackground(QColor(0xF4, 0xF5, 0xF7));
+        newBlock(bf);
+        QTextCharFormat cf;
+        cf.setFontFixedPitch(true);
+        cf.setFontFamilies({QStringLiteral("monospace")});
+        m_cursor.setBlockCharFormat(cf);
+        renderInline(content, cf, true);
+    }
+    else if (type == QLatin1String("blockquote") && listDepth == 0)
+    {
+        QTextBlockFormat bf = base;
+        bf.setProperty(kQuoteProperty, true);
+        bf.setLeftMargin(24);
+        for (const auto& child : content)
+        {
+            // Quotes hold paragraphs in practice; anything richer keeps its JSON.
+            if (typeOf(child) == QLatin1String("paragraph"))
+                renderBlockNode(child.toObject(), bf, listDepth);
+            else
+                renderPreserved(child.toObject(), bf);
+        }
+    }
+    else if (isList(type))
+    {
+        renderList(node, base, listDepth + 1);
+    }
+    else if (type == QLatin1String("table") && listDepth == 0 && !base.property(kQuoteProperty).toBool())
+    {
+        renderTable(node);
+    }
+    else if (type == QLatin1String("rule"))
+    {
+        QTextBlockFormat bf = base;
+        bf.setProperty(kRuleProperty, true);
+        bf.setProperty(QTextFormat::BlockTrailingHorizontalRulerWidth, QTextLength(QTextLength::PercentageLength, 100));
+        newBlock(bf);
+    }
+    else
+    {
+        renderPreserved(node, base);
+    }
+}
+
+void AdfTextMapper::renderList(const QJsonObject& list, const QTextBlockFormat& base, int depth)
+{
+    const bool ordered = typeOf(list) == QLatin1String("orderedList");
+    static const QTextListFormat::Style bullets[] = {QTextListFormat::ListDisc, QTextListFormat::ListCircle, QTextListFormat::ListSquare};
+    static const QTextListFormat::Style numbers[] = {QTextListFormat::ListDecimal, QTextListFormat::ListLowerAlpha, QTextListFormat::ListLowerRoman};
+
+    QTextListFormat lf;
+    lf.setIndent(depth);
+    lf.setStyle(ordered ? numbers[(depth - 1) % 3] : bullets[(depth - 1) % 3]);
+    if (ordered)
+    {
+        const int start = list.value(QLatin1String("attrs")).toObject().value(QLatin1String("order")).toInt(1);
+        if (start != 1)
+            lf.setProperty(kListStartProperty, start);
+    }
+
+    QTextBlockFormat continuation = base;
+    continuation.setIndent(depth);
+    continuation.setProperty(kContinuationProperty, depth);
+
+    QTextList* textList = nullptr;
+    const auto attach = [&]() {
+        if (!textList)
+            textList = m_cursor.createList(lf);
+        else
+            textList->add(m_cursor.block());
+    };
+
+    for (const auto& itemValue : list.value(QLatin1String("content")).toArray())
+    {
+        const auto item = itemValue.toObject();
+        const auto children = item.value(QLatin1String("content")).toArray();
+        if (typeOf(itemValue) != QLatin1String("listItem") || children.isEmpty())
+        {
+            newBlock(base);
+            attach();
+            continue;
+        }
+
+        bool first = true;
+        for (const auto& child : children)
+        {
+            if (isList(typeOf(child)))
+                renderList(child.toObject(), base, depth + 1);
+            else if (first)
+            {
+                renderBlockNode(child.toObject(), base, depth);
+                attach();
+            }
+            else
+                renderBlockNode(child.toObject(), continuation, depth);
+            first = false;
+        }
+    }
+}
+
+void AdfTextMapper::renderTable(const QJsonObject& table)
+{
+    const QJsonArray rows = table.value(QLatin1String("content")).toArray();
+    int columns = 0;
+    bool spans = false;
+    for (const auto& row : rows)
+    {
+        const auto cells = row.toObject().value(QLatin1String("content")).toArray();
+        columns = std::max(columns, int(cells.size()));
+        for (const auto& cell : cells)
+        {
+            const auto attrs = cell.toObject().value(QLatin1String("attrs")).toObject();
+            spans = spans || attrs.value(QLatin1String("colspan")).toInt(1) > 1 || attrs.value(QLatin1String("rowspan")).toInt(1) > 1;
+        }
+    }
+    if (rows.isEmpty() || columns == 0 || spans)
+    {
+        renderPreserved(table, QTextBlockFormat());
+        return;
+    }
+
+    if (m_reuseBlock)
+        m_cursor.block().setUserData(new AdfBlockData(m_nodeIndex, true));
+
+    QTextTableFormat tf;
+    tf.setBorder(1);
+    tf.setBorderCollapse(true);
+    tf.setCellPadding(4);
+    tf.setCellSpacing(0);
+    tf.setWidth(QTextLength(QTextLength::PercentageLength, 100));
+    tf.setProperty(kTableAttrsProperty, compact(table.value(QLatin1String("attrs")).toObject()));
+    QTextTable* textTable = m_cursor.insertTable(int(rows.size()), columns, tf);
+
+    for (int r = 0; r < rows.size(); ++r)
+    {
+        const auto cells = rows[r].toObject().value(QLatin1String("content")).toArray();
+        for (int c = 0; c < columns; ++c)
+        {
+            const auto cellNode = cells.at(c).toObject();
+            QTextTableCell cell = textTable->cellAt(r, c);
+
+            QTextTableCellFormat cf = cell.format().toTableCellFormat();
+            cf.setProperty(kCellAttrsProperty, compact(cellNode.value(QLatin1String("attrs")).toObject()));
+            if (typeOf(cellNode) == QLatin1String("tableHeader"))
+            {
+                cf.setProperty(kHeaderCellProperty, true);
+                cf.setBackground(QColor(0xF4, 0xF5, 0xF7));
+            }
+            cell.setFormat(cf);
+
+            m_cursor = cell.firstCursorPosition();
+            m_reuseBlock = true;
+            for (const auto& child : cellNode.value(QLatin1String("content")).toArray())
+                renderBlockNode(child.toObject(), QTextBlockFormat(), 0);
+            if (m_reuseBlock)
+                newBlock(QTextBlockFormat());
+        }
+    }
+
+    // Continue in the block after the table; it is reused by the next node.
+    m_cursor = textTable->lastCursorPosition();
+    m_cursor.movePosition(QTextCursor::NextBlock);
+    m_cursor.block().setUserData(new AdfBlockData(m_nodeIndex, true));
+    m_reuseBlock = true;
+}
+
+void AdfTextMapper::renderPreserved(const QJsonObject& node, const QTextBlockFormat& base)
+{
+    QString text = Adf::toPlainText(node);
+    if (text.isEmpty())
+        text = "[" + node.value(QLatin1String("type")).toString() + "]";
+    text.replace(QLatin1Char('\n'), QChar::LineSeparator);
+
+    QTextBlockFormat bf = base;
+    bf.setProperty(kPreservedProperty, compact(node));
+    bf.setProperty(kPreservedTextProperty, text);
+    newBlock(bf);
+
+    QTextCharFormat cf;
+    cf.setForeground(kMutedColor);
+    m_cursor.insertText(text, cf);
+}
+
+void AdfTextMapper::renderInline(const QJsonArray& content, const QTextCharFormat& base, bool code)
+{
+    for (const auto& v : content)
+    {
+        const auto node = v.toObject();
+        const auto type = node.value(QLatin1String("type")).toString();
+
+        if (type == QLatin1String("text"))
+        {
+            QString text = node.value(QLatin1String("text")).toString();
+            QTextCharFormat cf = base;
+            if (code)
+                text.replace(QLatin1Char('\n'), QChar::LineSeparator);
+            else
+                applyMarks(node.value(QLatin1String("marks")).toArray(), cf);
+            m_cursor.insertText(text, cf);
+            continue;
+        }
+        if (type == QLatin1String("hardBreak"))
+        {
+            m_cursor.insertText(QString(QChar::LineSeparator), base);
+            continue;
+        }
+
+        const auto attrs = node.value(QLatin1String("attrs")).toObject();
+        if (type == QLatin1String("mention"))
+        {
+            const auto id = attrs.value(QLatin1String("id")).toString();
+            QString text = attrs.value(QLatin1String("text")).toString();
+            if (text.isEmpty()) text = "@" + id;
+            QTextCharFormat cf = base;
+            cf.setProperty(kMentionIdProperty, id);
+            cf.setForeground(kLinkColor);
+            m_cursor.insertText(text, cf);
+            continue;
+        }
+
+        QString display;
+        QTextCharFormat cf = base;
+        if (type == QLatin1String("emoji"))
+        {
+            display = attrs.value(QLatin1String("text")).toString();
+            if (display.isEmpty()) display = attrs.value(QLatin1String("shortName")).toString();
+        }
+        else if (type == QLatin1String("status"))
+        {
+            display = "[" + attrs.value(QLatin1String("text")).toString() + "]";
+        }
+        else if (type == QLatin1String("date"))
+        {
+            const qint64 ms = attrs.value(QLatin1String("timestamp")).toString().toLongLong();
+            display = QDateTime::fromMSecsSinceEpoch(ms).toUTC().date().toString(Qt::ISODate);
+        }
+        else if (type == QLatin1String("inlineCard"))
+        {
+            display = attrs.value(QLatin1String("url")).toString();
+            cf.setAnchor(true);
+            cf.setAnchorHref(display);
+            cf.setForeground(kLinkColor);
+        }
+        else
+        {
+            const auto children = node.value(QLatin1String("content"));
+            if (children.isArray())
+                renderInline(children.toArray(), base, code);
+            continue;
+        }
+
+        cf.setProperty(kInlineNodeProperty, compact(node));
+        cf.setProperty(kInlineTextProperty, display);
+        m_cursor.insertText(display, cf);
+    }
+}
+
+QJsonObject AdfTextMapper::toAdf(int* reconverted) const
+{
+    m_built = Built{};
+    const QJsonObject adf = build(reconverted, &m_built.nodeOf);
+    if (m_document && !adf.isEmpty())
+    {
+        m_built.revision = m_document->revision();
+        m_built.content = adf.value(QLatin1String("content")).toArray();
+    }
+    return adf;
+}
+
+void AdfTextMapper::commit(const QJsonObject& adf)
+{
+    if (!m_document || m_loading)
+        return;
+
+    // Only rebase onto what the last toAdf() built from the document as it still is.
+    const QJsonArray content = adf.value(QLatin1String("content")).toArray();
+    if (m_built.revision != m_document->revision() || m_built.content != content)
+        return;
+    const QList<int> nodeOf = std::exchange(m_built, Built{}).nodeOf;
+
+    m_nodes.clear();
+    m_nodes.reserve(content.size());
+    for (const auto& node : content)
+        m_nodes.append(Node{node.toObject()});
+
+    const auto attach = [this](QTextBlock b, int node) {
+        auto* d = dataOf(b);
+        if (!d)
+        {
+            d = new AdfBlockData(node, false);
+            b.setUserData(d);
+        }
+        d->node = node;
+        d->structural = false;
+        d->fingerprint = fingerprint(b);
+        if (node >= 0)
+            ++m_nodes[node].blocks;
+    };
+
+    const auto items = itemsOf(m_document->rootFrame()->begin());
+    for (qsizetype i = 0; i < items.size(); ++i)
+    {
+        const int node = nodeOf[i];
+        if (node == kSkipped)
+            continue;
+        if (items[i].table)
+        {
+            for (const auto& b : blocksOf(items[i].table))
+                attach(b, node);
+        }
+        else
+        {
+            attach(items[i].block, node);
+        }
+        if (node >= 0)
+            ++m_nodes[node].items;
+    }
+
+    m_document->setModified(false);
+}
+
+QJsonObject AdfTextMapper::build(int* reconverted, QList<int>* nodeOf) const
+{
+    if (reconverted)
+        *reconverted = 0;
+    if (!m_document || m_loading)
+        return QJsonObject();
+
+    // Attribute each top-level item to the node it was rendered from. New blocks inside a
+    // list belong to the list they were typed into.
+    struct Top
+    {
+        Item item;
+        int node{-1};
+        bool clean{false};
+        int blocks{0};
+    };
+    QList<Top> tops;
+    QList<qsizetype> topItem; // index into `items`, per top
+    int previousNode = -1;
+    bool previousInList = false;
+    const auto items = itemsOf(m_document->rootFrame()->begin());
+    for (qsizetype index = 0; index < items.size(); ++index)
+    {
+        const Item& item = items[index];
+        Top top{item};
+        if (item.table)
+        {
+            const auto blocks = blocksOf(item.table);
+            const auto* first = blocks.isEmpty() ? nullptr : dataOf(blocks.first());
+            top.node = first && !first->structural ? first->node : -1;
+            top.clean = top.node >= 0;
+            for (const auto& b : blocks)
+            {
+                const auto* d = dataOf(b);
+                top.clean = top.clean && d && d->node == top.node && d->fingerprint == fingerprint(b);
+            }
+            top.blocks = int(blocks.size());
+            previousInList = false;
+        }
+        else
+        {
+            const QTextBlock& b = item.block;
+            const auto* d = dataOf(b);
+            if (d && d->structural && b.text().isEmpty())
+                continue;
+
+            const bool inList = b.textList() || b.blockFormat().hasProperty(kContinuationProperty);
+            if (d && !d->structural)
+            {
+                top.node = d->node;
+                top.clean = d->fingerprint == fingerprint(b);
+            }
+            else if (inList && previousInList)
+            {
+                top.node = previousNode;
+            }
+            top.blocks = 1;
+            previousInList = inList;
+        }
+        previousNode = top.node;
+        tops.append(top);
+        topItem.append(index);
+    }
+
+    // Group consecutive items of the same node into runs.
+    struct Run
+    {
+        qsizetype begin;
+        qsizetype end;
+        int node;
+        bool clean;
+    };
+    QList<Run> runs;
+    QHash<int, int> runsPerNode;
+    for (qsizetype i = 0; i < tops.size();)
+    {
+        qsizetype j = i + 1;
+        while (j < tops.size() && tops[j].node >= 0 && tops[j].node == tops[i].node)
+            ++j;
+
+        Run run{i, j, tops[i].node, tops[i].node >= 0 && tops[i].node < m_nodes.size()};
+        int blocks = 0;
+        for (qsizetype k = i; k < j; ++k)
+        {
+            run.clean = run.clean && tops[k].clean;
+            blocks += tops[k].blocks;
+        }
+        if (run.clean)
+        {
+            const auto& source = m_nodes[run.node];
+            run.clean = source.items == j - i && source.blocks == blocks;
+        }
+        if (run.node >= 0)
+            ++runsPerNode[run.node];
+        runs.append(run);
+        i = j;
+    }
+
+    QJsonArray content;
+    QList<Item> dirty;
+    QList<qsizetype> dirtyTops;
+    QList<int> nodeOfTop(tops.size(), -1); // index into `content`
+    int converted = 0;
+    int lastNode = -1;
+    const auto flush = [&]() {
+        if (dirty.isEmpty()) return;
+        QList<int> nodes;
+        const int base = int(content.size());
+        for (const auto& node : convertItems(dirty, nodeOf ? &nodes : nullptr))
+        {
+            content.append(node);
+            ++converted;
+        }
+        for (qsizetype k = 0; k < nodes.size(); ++k)
+            nodeOfTop[dirtyTops[k]] = base + nodes[k];
+        dirty.clear();
+        dirtyTops.clear();
+    };
+
+    for (const auto& run : runs)
+    {
+        // Nodes split apart or reordered by an edit are rebuilt, not reused.
+        if (run.clean && runsPerNode.value(run.node) == 1 && run.node > lastNode)
+        {
+            flush();
+            for (qsizetype k = run.begin; k < run.end; ++k)
+                nodeOfTop[k] = int(content.size());
+            content.append(m_nodes[run.node].json);
+            lastNode = run.node;
+            continue;
+        }
+        for (qsizetype k = run.begin; k < run.end; ++k)
+        {
+            dirty.append(tops[k].item);
+            dirtyTops.append(k);
+        }
+    }
+    flush();
+
+    // Trailing empty paragraphs are editor leftovers.
+    while (!content.isEmpty())
+    {
+        const auto last = content.last().toObject();
+        if (last.value(QLatin1String("type")).toString() != QLatin1String("paragraph") || !last.value(QLatin1String("content")).toArray().isEmpty())
+            break;
+        content.removeLast();
+    }
+
+    if (nodeOf)
+    {
+        // Items dropped above (structural or trailing empty) belong to no node.
+        nodeOf->fill(kSkipped, items.size());
+        for (qsizetype k = 0; k < tops.size(); ++k)
+            (*nodeOf)[topItem[k]] = nodeOfTop[k] < content.size() ? nodeOfTop[k] : -1;
+    }
+
+    if (reconverted)
+        *reconverted = converted;
+    return QJsonObject{{"version", 1}, {"type", "doc"}, {"content", content}};
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QTextCursor>
+
+class QTextDocument;
+
+// Maps an ADF document onto a QTextDocument and back, keeping structure: headings,
+// marks (bold, italic, code, links, ...), nested lists, code blocks, quotes, rules,
+// tables and mentions. Nodes the editor cannot represent are shown as their text and
+// written back verbatim unless that text is edited.
+//
+// Every top-level ADF node remembers the blocks it was rendered into. toAdf() reuses the
+// original JSON for nodes whose blocks are untouched and only converts edited ones.
+//
+// Large documents render progressively: load() renders the first slice immediately and
+// the rest in short slices on the event loop, then emits loadFinished().
+class AdfTextMapper : public QObject
+{
+    Q_OBJECT
+public:
+    explicit AdfTextMapper(QTextDocument* document, QObject* parent = nullptr);
+
+    void load(const QJsonObject& adf);
+    void loadPlainText(const QString& text);
+    // Stops a running load and forgets the loaded nodes; the document is left as is.
+    void clear();
+
+    bool isLoading() const { return m_loading; }
+
+    // `reconverted` receives the number of top-level nodes rebuilt from the editor.
+    QJsonObject toAdf(int* reconverted = nullptr) const;
+    // Makes `adf`, just built by toAdf() and sent, the new baseline: its nodes are reused
+    // for untouched blocks from now on and the document is marked unmodified. Nothing is
+    // re-rendered. Ignored if the document changed since toAdf().
+    void commit(const QJsonObject& adf);
+
+signals:
+    void loadFinished();
+
+private:
+    struct Node
+    {
+        QJsonObject json;
+        int items{0};  // top-level blocks/tables it was rendered into
+        int blocks{0}; // all blocks, including table cells
+    };
+
+    void renderSlice();
+    void finishLoad();
+    // toAdf(); `nodeOf` receives, per top-level item of the document, the index of the
+    // output node it went into, -1 if none, or kSkipped for structural blocks.
+    QJsonObject build(int* reconverted, QList<int>* nodeOf) const;
+    static constexpr int kSkipped = -2;
+
+    void renderBlockNode(const QJsonObject& node, const QTextBlockFormat& base, int listDepth);
+    void renderList(const QJsonObject& list, const QTextBlockFormat& base, int depth);
+    void renderTable(const QJsonObject& table);
+    void renderPreserved(const QJsonObject& node, const QTextBlockFormat& base);
+    void renderInline(const QJsonArray& content, const QTextCharFormat& base, bool code);
+    void newBlock(const QTextBlockFormat& format);
+
+    // What the last toAdf() produced, for commit().
+    struct Built
+    {
+        int revision{-1};
+        QJsonArray content;
+        QList<int> nodeOf;
+    };
+
+    QPointer<QTextDocument> m_document;
+    QList<Node> m_nodes;
+    mutable Built m_built;
+    QJsonArray m_pending;
+    qsizetype m_next{0};
+    quint64 m_generation{0};
+    bool m_loading{false};
+
+    QTextCursor m_cursor;
+    bool m_reuseBlock{false};
+    int m_nodeIndex{-1};
+};
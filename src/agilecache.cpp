@@ -0,0 +1,205 @@
+#include "agilecache.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <QSet>
+
+static constexpr quint32 kMagic = 0x4A584143; // "JXAC"
+static constexpr quint16 kVersion = 1;
+
+static QDataStream& operator<<(QDataStream& s, const JiraBoard& b)
+{
+    return s << qint32(b.id) << b.name << b.type;
+}
+
+static QDataStream& operator>>(QDataStream& s, JiraBoard& b)
+{
+    qint32 id = 0;
+    s >> id >> b.name >> b.type;
+    b.id = id;
+    return s;
+}
+
+static QDataStream& operator<<(QDataStream& s, const JiraSprint& sp)
+{
+    return s << qint32(sp.id) << sp.name << sp.state << sp.startDate << sp.endDate;
+}
+
+static QDataStream& operator>>(QDataStream& s, JiraSprint& sp)
+{
+    qint32 id = 0;
+    s >> id >> sp.name >> sp.state >> sp.startDate >> sp.endDate;
+    sp.id = id;
+    return s;
+}
+
+void AgileCache::clear()
+{
+    m_boards.clear();
+    m_boardSprints.clear();
+    m_sprints.clear();
+}
+
+bool AgileCache::isFresh(const QDateTime& fetched, qint64 ttlSecs)
+{
+    return fetched.isValid() && fetched.secsTo(QDateTime::currentDateTimeUtc()) < ttlSecs;
+}
+
+std::optional<QList<JiraBoard>> AgileCache::boards(const QString& type) const
+{
+    const auto it = m_boards.constFind(type);
+    if (it == m_boards.constEnd())
+        return std::nullopt;
+    return it->boards;
+}
+
+bool AgileCache::boardsFresh(const QString& type) const
+{
+    const auto it = m_boards.constFind(type);
+    return it != m_boards.constEnd() && isFresh(it->fetched, kBoardsTtlSecs);
+}
+
+void AgileCache::setBoards(const QString& type, const QList<JiraBoard>& boards)
+{
+    m_boards.insert(type, BoardList{boards, QDateTime::currentDateTimeUtc()});
+}
+
+std::optional<QList<JiraSprint>> AgileCache::boardSprints(int boardId, const QString& state) const
+{
+    const auto it = m_boardSprints.constFind(qMakePair(boardId, state));
+    if (it == m_boardSprints.constEnd())
+        return std::nullopt;
+
+    QList<JiraSprint> sprints;
+    sprints.reserve(it->sprintIds.size());
+    for (const int id : it->sprintIds)
+    {
+        const auto s = m_sprints.constFind(id);
+        if (s != m_sprints.constEnd())
+            sprints.append(*s);
+    }
+    return sprints;
+}
+
+std::optional<JiraSprint> AgileCache::sprint(int sprintId) const
+{
+    const auto it = m_sprints.constFind(sprintId);
+    if (it == m_sprints.constEnd())
+        return std::nullopt;
+    return *it;
+}
+
+bool AgileCache::boardSprintsFresh(int boardId, const QString& state) const
+{
+    const auto it = m_boardSprints.constFind(qMakePair(boardId, state));
+    return it != m_boardSprints.constEnd() && isFresh(it->fetched, kSprintsTtlSecs);
+}
+
+void AgileCache::setBoardSprints(int boardId, const QString& state, const QList<JiraSprint>& sprints)
+{
+    SprintList list;
+    list.fetched = QDateTime::currentDateTimeUtc();
+    list.sprintIds.reserve(sprints.size());
+    for (const auto& s : sprints)
+    {
+        list.sprintIds.append(s.id);
+        m_sprints.insert(s.id, s);
+    }
+    m_boardSprints.insert(qMakePair(boardId, state), list);
+}
+
+bool AgileCache::load(const QString& identity, const QString& path)
+{
+    QFile f(path);
+    if (!f.exists() || !f.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&f);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    QString storedIdentity;
+    in >> magic >> version;
+    if (magic != kMagic || version != kVersion)
+        return false;
+    in >> storedIdentity;
+    if (storedIdentity != identity)
+        return false;
+
+    AgileCache loaded;
+
+    quint32 boardTypes = 0;
+    in >> boardTypes;
+    for (quint32 i = 0; i < boardTypes && in.status() == QDataStream::Ok; ++i)
+    {
+        QString type;
+        BoardList list;
+        in >> type >> list.boards >> list.fetched;
+        loaded.m_boards.insert(type, list);
+    }
+
+    quint32 mappings = 0;
+    in >> mappings;
+    for (quint32 i = 0; i < mappings && in.status() == QDataStream::Ok; ++i)
+    {
+        qint32 boardId = 0;
+        QString state;
+        SprintList list;
+        in >> boardId >> state >> list.sprintIds >> list.fetched;
+        loaded.m_boardSprints.insert(qMakePair(int(boardId), state), list);
+    }
+
+    QList<JiraSprint> sprints;
+    in >> sprints;
+    for (const auto& s : sprints)
+        loaded.m_sprints.insert(s.id, s);
+
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    *this = std::move(loaded);
+    return true;
+}
+
+bool AgileCache::save(const QString& identity, const QString& path) const
+{
+    QSaveFile out(path);
+    if (!out.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream s(&out);
+    s.setVersion(QDataStream::Qt_6_0);
+    s << kMagic << kVersion << identity;
+
+    s << quint32(m_boards.size());
+    for (auto it = m_boards.cbegin(); it != m_boards.cend(); ++it)
+        s << it.key() << it->boards << it->fetched;
+
+    // Only sprints some board still points at; the rest have rolled off.
+    QSet<int> referenced;
+    s << quint32(m_boardSprints.size());
+    for (auto it = m_boardSprints.cbegin(); it != m_boardSprints.cend(); ++it)
+    {
+        s << qint32(it.key().first) << it.key().second << it->sprintIds << it->fetched;
+        for (const int id : it->sprintIds)
+            referenced.insert(id);
+    }
+
+    QList<JiraSprint> sprints;
+    for (const int id : referenced)
+    {
+        const auto sp = m_sprints.constFind(id);
+        if (sp != m_sprints.constEnd())
+            sprints.append(*sp);
+    }
+    s << sprints;
+
+    if (s.status() != QDataStream::Ok)
+    {
+        out.cancelWriting();
+        return false;
+    }
+    return out.commit();
+}
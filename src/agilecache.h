@@ -0,0 +1,59 @@
+#pragma once
+
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QString>
+
+#include <optional>
+
+#include "models.h"
+
+// Boards, sprints and the board -> sprint mapping from the Agile API, each stamped with
+// when it was fetched. Boards rarely change and sprints roll over every couple of weeks,
+// so lookups are answered from here and only expired entries go back to the network.
+// Persisted next to appsettings.json so the TTLs carry over between sessions.
+class AgileCache
+{
+public:
+    static constexpr qint64 kBoardsTtlSecs = 24 * 60 * 60;
+    static constexpr qint64 kSprintsTtlSecs = 60 * 60;
+
+    void clear();
+
+    // Last fetched board list of this type (any age), or nullopt if never fetched.
+    std::optional<QList<JiraBoard>> boards(const QString& type) const;
+    bool boardsFresh(const QString& type) const;
+    void setBoards(const QString& type, const QList<JiraBoard>& boards);
+
+    // Last fetched sprints of `state` on a board (any age), or nullopt if never fetched.
+    std::optional<QList<JiraSprint>> boardSprints(int boardId, const QString& state) const;
+    bool boardSprintsFresh(int boardId, const QString& state) const;
+    void setBoardSprints(int boardId, const QString& state, const QList<JiraSprint>& sprints);
+    // A sprint seen on any board, or nullopt if none listed it.
+    std::optional<JiraSprint> sprint(int sprintId) const;
+
+    // `identity` (instance URL + user) must match for load() to succeed.
+    bool load(const QString& identity, const QString& path = QStringLiteral("agilecache.bin"));
+    bool save(const QString& identity, const QString& path = QStringLiteral("agilecache.bin")) const;
+
+private:
+    struct BoardList
+    {
+        QList<JiraBoard> boards;
+        QDateTime fetched;
+    };
+
+    struct SprintList
+    {
+        QList<int> sprintIds;
+        QDateTime fetched;
+    };
+
+    static bool isFresh(const QDateTime& fetched, qint64 ttlSecs);
+
+    QHash<QString, BoardList> m_boards;                 // by board type
+    QHash<QPair<int, QString>, SprintList> m_boardSprints; // by (board id, sprint state)
+    QHash<int, JiraSprint> m_sprints;                   // by sprint id; shared between boards
+};
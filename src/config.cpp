@@ -14,6 +14,10 @@ static AppConfig fromJson(const QJsonObject& root)
     cfg.jira.username = jiraObj.value("Username").toString();
     cfg.jira.apiToken = jiraObj.value("ApiToken").toString();
 
+    const auto networkObj = root.value("Network").toObject();
+    cfg.network.maxConcurrentRequests = networkObj.value("MaxConcurrentRequests").toInt(cfg.network.maxConcurrentRequests);
+    cfg.network.httpCacheMaxMB = networkObj.value("HttpCacheMaxMB").toInt(cfg.network.httpCacheMaxMB);
+
     return cfg;
 }
 
@@ -24,8 +28,13 @@ static QJsonObject toJson(const AppConfig& cfg)
     jira.insert("Username", cfg.jira.username);
     jira.insert("ApiToken", cfg.jira.apiToken);
 
+    QJsonObject network;
+    network.insert("MaxConcurrentRequests", cfg.network.maxConcurrentRequests);
+    network.insert("HttpCacheMaxMB", cfg.network.httpCacheMaxMB);
+
     QJsonObject root;
     root.insert("Jira", jira);
+    root.insert("Network", network);
     return root;
 }
 
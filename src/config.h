@@ -9,9 +9,18 @@ struct JiraConfig
     QString apiToken;
 };
 
+struct NetworkConfig
+{
+    // Requests beyond this many wait in JiraClient's scheduler queue.
+    int maxConcurrentRequests{6};
+    // Size cap of the on-disk HTTP response cache (httpcache/).
+    int httpCacheMaxMB{50};
+};
+
 struct AppConfig
 {
     JiraConfig jira;
+    NetworkConfig network;
 };
 
 class ConfigService
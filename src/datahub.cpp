@@ -1,19 +1,386 @@
 #include "datahub.h"
 #include "jira_client.h"
+#include "ticketcache.h"
+
+#include <QHash>
+#include <QSet>
+
+#include <algorithm>
 
 DataHub::DataHub(JiraClient* client, QObject* parent)
     : QObject(parent), m_client(client)
 {
     Q_ASSERT(m_client);
 
-    connect(m_client, &JiraClient::myTicketsReady, this, [this](const QList<JiraTicket>& tickets) {
-        m_currentTickets = tickets;
-        emit ticketsUpdated(m_currentTickets);
+    connect(m_client, &JiraClient::myTicketsPage, this, &DataHub::applyPage);
+    connect(m_client, &JiraClient::myTicketsReady, this, &DataHub::applyFull);
+    connect(m_client, &JiraClient::myTicketsDeltaReady, this, &DataHub::applyDelta);
+    connect(m_client, &JiraClient::myTicketKeysReady, this, &DataHub::applyKeys);
+
+    connect(m_client, &JiraClient::issueFieldSnapshotReady, this, [this](const QString& key, const JiraIssueFieldSnapshot& s, bool complete) {
+        if (key.isEmpty() || !complete) return;
+        setFetchedFields(key, s);
+        auto& d = detailsFor(key);
+        d.fields = s;
+        d.valid = true;
+        indexTicket(key);
+        applySprint(key, s);
+        scheduleSave();
+    });
+    connect(m_client, &JiraClient::issueCommentsReady, this, [this](const QString& key, const QList<JiraComment>& comments, bool complete) {
+        if (key.isEmpty() || !complete) return;
+        auto& d = detailsFor(key);
+        d.comments = comments;
+        d.valid = true;
+        indexTicket(key);
+        scheduleSave();
+    });
+    connect(m_client, &JiraClient::issueHistoryReady, this, [this](const QString& key, const QList<JiraHistoryEntry>& entries, bool complete) {
+        if (key.isEmpty() || !complete) return;
+        auto& d = detailsFor(key);
+        d.history = entries;
+        d.valid = true;
+        scheduleSave();
+    });
+
+    connect(m_client, &JiraClient::issueDetailsReady, this, [this](const JiraIssueDetails& details) {
+        if (details.key.isEmpty() || !details.valid) return;
+        setFetchedFields(details.key, details.fields);
+        m_details.insert(details.key, details);
+        indexTicket(details.key);
+        scheduleSave();
     });
+
+    connect(m_client, &JiraClient::issueFieldsEdited, this, &DataHub::applyFieldEdit);
+    connect(m_client, &JiraClient::issueFieldsSaved, this, &DataHub::confirmFieldEdit);
+    connect(m_client, &JiraClient::issueFieldsReverted, this, &DataHub::revertFieldEdit);
+
+    // One refresh after a bulk operation rather than one per issue it touched.
+    connect(m_client, &JiraClient::bulkFinished, this, [this](const JiraBulkResult& result) {
+        if (!result.succeeded.isEmpty())
+            refreshMyTickets();
+    });
+
+    // Coalesce bursts of updates into one write.
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(2000);
+    connect(&m_saveTimer, &QTimer::timeout, this, &DataHub::saveCache);
+}
+
+DataHub::~DataHub()
+{
+    if (m_saveTimer.isActive())
+        saveCache();
 }
 
-void DataHub::refreshMyTickets()
+void DataHub::openCache(const QString& identity)
 {
-    if (m_client)
+    if (identity == m_cacheIdentity)
+        return;
+
+    if (m_saveTimer.isActive())
+    {
+        m_saveTimer.stop();
+        saveCache();
+    }
+
+    m_cacheIdentity = identity;
+    m_tickets.clear();
+    m_details.clear();
+    m_pendingFields.clear();
+    m_search.clear();
+    resetSync();
+
+    TicketCacheData data;
+    if (TicketCache::load(data) && data.identity == identity)
+    {
+        m_tickets.assign(data.tickets);
+        m_details = std::move(data.details);
+        // Resume delta sync from where the last session left off; the first delta after
+        // startup also reconciles, since m_lastReconcile is unset.
+        m_watermark = data.watermark;
+    }
+
+    // A missing or stale index is rebuilt from the cached text; otherwise only
+    // documents whose content changed are touched.
+    m_search.load(identity);
+    reindexAll();
+
+    publishTickets("TicketCache");
+}
+
+const JiraIssueDetails* DataHub::cachedDetails(const QString& issueKey) const
+{
+    const auto it = m_details.constFind(issueKey);
+    return it == m_details.constEnd() || !it->valid ? nullptr : &it.value();
+}
+
+void DataHub::refreshMyTickets(bool forceFull)
+{
+    if (!m_client)
+        return;
+
+    if (forceFull || !m_deltaSyncEnabled || !m_watermark.isValid())
         m_client->getMyTickets();
+    else
+        m_client->getMyTicketsUpdatedSince(m_watermark);
+}
+
+void DataHub::resetSync()
+{
+    m_watermark = QDateTime();
+    m_lastReconcile = QDateTime();
+}
+
+void DataHub::applyPage(const QList<JiraTicket>& tickets)
+{
+    // m_tickets stays the last complete set; only the views see partial pages.
+    auto& tracer = m_client->tracer();
+    const qint64 start = tracer.now();
+    emit ticketsBatch(tickets);
+    tracer.record(tracer.endpoint("GetMyTickets"), RequestTracer::Phase::Apply, start, tracer.now() - start);
+}
+
+void DataHub::applyFull(const QList<JiraTicket>& tickets, bool complete)
+{
+    // A partial list would read as every missing ticket being gone; keep the last
+    // complete set, and put it back in the views that saw the partial pages.
+    if (!complete)
+    {
+        publishTickets("GetMyTickets");
+        return;
+    }
+
+    m_tickets.assign(tickets);
+    // A full fetch is an implicit reconcile.
+    m_watermark = QDateTime();
+    // Newest first, so the first row holds the watermark.
+    if (!m_tickets.isEmpty())
+        advanceWatermark(m_tickets.updated().first());
+    m_lastReconcile = QDateTime::currentDateTimeUtc();
+    reindexAll();
+    publishTickets("GetMyTickets");
+    scheduleSave();
+}
+
+void DataHub::applyDelta(const QList<JiraTicket>& tickets, bool complete)
+{
+    if (!tickets.isEmpty())
+    {
+        // Keeps the server's "ORDER BY updated DESC" ordering.
+        m_tickets.upsert(tickets);
+        for (const auto& t : tickets)
+            indexTicket(m_tickets.rowOf(t.key));
+        emit searchIndexUpdated();
+    }
+
+    // Pages arrive newest first, so a partial result may have skipped older changes;
+    // only a complete delta may move the watermark.
+    if (complete)
+        advanceWatermark(tickets);
+
+    publishTickets("GetMyTicketsDelta");
+    scheduleSave();
+
+    if (complete && reconcileDue())
+        m_client->getMyTicketKeys();
+}
+
+void DataHub::applyKeys(const QStringList& keys, bool complete)
+{
+    // Never drop tickets based on a truncated key list.
+    if (!complete)
+        return;
+
+    m_lastReconcile = QDateTime::currentDateTimeUtc();
+
+    const QSet<QString> live(keys.cbegin(), keys.cend());
+    const auto removed = m_tickets.retain(live);
+
+    // Keys we have never seen (e.g. re-assigned without an `updated` bump) need the full payload.
+    if (live.size() > m_tickets.size())
+    {
+        refreshMyTickets(true);
+        return;
+    }
+
+    if (removed > 0)
+    {
+        for (const auto& key : m_search.keys())
+            if (!live.contains(key))
+                m_search.removeDocument(key);
+        emit searchIndexUpdated();
+        publishTickets("GetMyTicketKeys");
+        scheduleSave();
+    }
+}
+
+void DataHub::publishTickets(const QString& source)
+{
+    // Model/view updates run synchronously off this signal; record them as the Apply
+    // phase of the request that produced the data.
+    auto& tracer = m_client->tracer();
+    const qint64 start = tracer.now();
+    emit ticketsUpdated(m_tickets.toList());
+    tracer.record(tracer.endpoint(source), RequestTracer::Phase::Apply, start, tracer.now() - start);
+}
+
+void DataHub::advanceWatermark(const QList<JiraTicket>& tickets)
+{
+    for (const auto& t : tickets)
+        if (t.updated.isValid() && (!m_watermark.isValid() || t.updated > m_watermark))
+            m_watermark = t.updated;
+}
+
+void DataHub::advanceWatermark(qint64 updatedMs)
+{
+    if (updatedMs == TicketStore::kNoTimestamp)
+        return;
+    const auto updated = QDateTime::fromMSecsSinceEpoch(updatedMs).toUTC();
+    if (!m_watermark.isValid() || updated > m_watermark)
+        m_watermark = updated;
+}
+
+bool DataHub::reconcileDue() const
+{
+    return !m_lastReconcile.isValid()
+        || m_lastReconcile.secsTo(QDateTime::currentDateTimeUtc()) >= m_reconcileIntervalSecs;
+}
+
+JiraIssueDetails& DataHub::detailsFor(const QString& issueKey)
+{
+    auto& d = m_details[issueKey];
+    d.key = issueKey;
+    return d;
+}
+
+void DataHub::applyFieldEdit(const QString& issueKey, const JiraFieldEdit& edit)
+{
+    auto& fields = detailsFor(issueKey).fields;
+    auto pending = m_pendingFields.find(issueKey);
+    if (pending == m_pendingFields.end())
+        pending = m_pendingFields.insert(issueKey, PendingFields{fields, 0});
+    pending->edited |= edit.fields;
+
+    edit.applyTo(fields);
+    if (edit.fields & JiraFieldEdit::Description)
+        indexTicket(issueKey);
+    if (edit.fields & JiraFieldEdit::Sprint)
+        applySprint(issueKey, fields);
+    scheduleSave();
+}
+
+void DataHub::confirmFieldEdit(const QString& issueKey, const JiraFieldEdit& edit)
+{
+    const auto pending = m_pendingFields.find(issueKey);
+    if (pending == m_pendingFields.end())
+        return;
+    edit.applyTo(pending->confirmed);
+    if (!m_client->hasPendingFieldEdits(issueKey))
+        m_pendingFields.erase(pending);
+}
+
+void DataHub::revertFieldEdit(const QString& issueKey, const JiraFieldEdit& edit)
+{
+    const auto pending = m_pendingFields.find(issueKey);
+    if (pending == m_pendingFields.end())
+        return;
+
+    auto& fields = detailsFor(issueKey).fields;
+    JiraFieldEdit::copyFields(edit.fields, pending->confirmed, fields);
+    if (!m_client->hasPendingFieldEdits(issueKey))
+        m_pendingFields.erase(pending);
+
+    if (edit.fields & JiraFieldEdit::Description)
+        indexTicket(issueKey);
+    if (edit.fields & JiraFieldEdit::Sprint)
+        applySprint(issueKey, fields);
+    scheduleSave();
+    emit issueFieldsReverted(issueKey, fields);
+}
+
+void DataHub::applySprint(const QString& issueKey, const JiraIssueFieldSnapshot& fields)
+{
+    // A sprint id without a name is a move whose name is still being fetched.
+    if (fields.sprintId.has_value() && fields.sprintName.isEmpty())
+        return;
+    const auto row = m_tickets.rowOf(issueKey);
+    if (row < 0 || m_tickets.sprints()[row] == fields.sprintName)
+        return;
+
+    auto ticket = m_tickets.ticket(row);
+    ticket.sprint = fields.sprintName;
+    m_tickets.upsert({ticket});
+    publishTickets("UpdateFields");
+    emit issueSprintChanged(issueKey, fields);
+}
+
+void DataHub::setFetchedFields(const QString& issueKey, const JiraIssueFieldSnapshot& fields)
+{
+    // The client re-applies pending edits to what it fetched; only the other fields are
+    // news from Jira.
+    const auto pending = m_pendingFields.find(issueKey);
+    if (pending != m_pendingFields.end())
+        JiraFieldEdit::copyFields(JiraFieldEdit::All & ~pending->edited, fields, pending->confirmed);
+}
+
+void DataHub::indexTicket(qsizetype row)
+{
+    if (row < 0)
+        return;
+    const auto& key = m_tickets.keys()[row];
+
+    QString description;
+    QStringList comments;
+    const auto it = m_details.constFind(key);
+    if (it != m_details.constEnd())
+    {
+        description = it->fields.description;
+        comments.reserve(it->comments.size());
+        for (const auto& c : it->comments)
+            comments.append(c.editableBody);
+    }
+    m_search.setDocument(key, m_tickets.summaries()[row], description, comments);
+}
+
+void DataHub::indexTicket(const QString& issueKey)
+{
+    const auto row = m_tickets.rowOf(issueKey);
+    if (row < 0)
+        return;
+    indexTicket(row);
+    emit searchIndexUpdated();
+}
+
+void DataHub::reindexAll()
+{
+    for (qsizetype row = 0; row < m_tickets.size(); ++row)
+        indexTicket(row);
+    for (const auto& key : m_search.keys())
+        if (m_tickets.rowOf(key) < 0)
+            m_search.removeDocument(key);
+    emit searchIndexUpdated();
+}
+
+void DataHub::scheduleSave()
+{
+    if (!m_cacheIdentity.isEmpty())
+        m_saveTimer.start();
+}
+
+void DataHub::saveCache()
+{
+    if (m_cacheIdentity.isEmpty())
+        return;
+
+    // Only keep details for tickets that are still ours so the file stays bounded.
+    m_details.removeIf([this](const QHash<QString, JiraIssueDetails>::iterator it) { return m_tickets.rowOf(it.key()) < 0; });
+
+    TicketCacheData data;
+    data.identity = m_cacheIdentity;
+    data.watermark = m_watermark;
+    data.tickets = m_tickets.toList();
+    data.details = m_details;
+    TicketCache::save(data);
+    m_search.save(m_cacheIdentity);
 }
@@ -1,9 +1,15 @@
 #pragma once
 
 #include <QObject>
+#include <QDateTime>
+#include <QHash>
 #include <QList>
+#include <QStringList>
+#include <QTimer>
 
 #include "models.h"
+#include "searchindex.h"
+#include "ticketstore.h"
 
 class JiraClient;
 
@@ -12,15 +18,86 @@ class DataHub : public QObject
     Q_OBJECT
 public:
     explicit DataHub(JiraClient* client, QObject* parent = nullptr);
+    ~DataHub() override;
 
-    const QList<JiraTicket>& currentTickets() const { return m_currentTickets; }
+    // The last complete ticket set, as columns. ticketsUpdated carries it materialized.
+    const TicketStore& tickets() const { return m_tickets; }
 
-    void refreshMyTickets();
+    // The first refresh (or a forced one) re-fetches everything. Later refreshes only pull
+    // tickets updated since the high-water `updated` timestamp and merge them by key; every
+    // reconcileIntervalSecs a keys-only query drops tickets that left the result set.
+    void refreshMyTickets(bool forceFull = false);
+
+    void setDeltaSyncEnabled(bool enabled) { m_deltaSyncEnabled = enabled; }
+    void setReconcileInterval(int seconds) { m_reconcileIntervalSecs = seconds; }
+
+    // Switch to the on-disk cache for `identity` (instance URL + user). When it changes the
+    // in-memory state is dropped and the matching cache, if any, is loaded synchronously
+    // and published via ticketsUpdated before any network request is made.
+    void openCache(const QString& identity);
+
+    // Last known details for an issue (from this session or the cache), or nullptr.
+    const JiraIssueDetails* cachedDetails(const QString& issueKey) const;
+
+    // Full-text index over ticket keys, summaries and whatever descriptions and comments
+    // have been fetched. Kept current as tickets and details arrive and persisted with the cache.
+    const SearchIndex& searchIndex() const { return m_search; }
+
+    // Forget the watermark so the next refresh is a full one (e.g. after a config change).
+    void resetSync();
 
 signals:
     void ticketsUpdated(const QList<JiraTicket>& tickets);
+    // A page of a full refresh, ahead of the ticketsUpdated that completes it. Views can
+    // upsert these; removals only show up in the final list.
+    void ticketsBatch(const QList<JiraTicket>& tickets);
+    void searchIndexUpdated();
+    // A field edit was refused and the cached fields rolled back to `fields`.
+    void issueFieldsReverted(const QString& issueKey, const JiraIssueFieldSnapshot& fields);
+    // An edit, revert or refetch moved the ticket to another sprint; `fields` is the
+    // cached snapshot after the move.
+    void issueSprintChanged(const QString& issueKey, const JiraIssueFieldSnapshot& fields);
 
 private:
+    void applyPage(const QList<JiraTicket>& tickets);
+    void applyFull(const QList<JiraTicket>& tickets, bool complete);
+    void applyDelta(const QList<JiraTicket>& tickets, bool complete);
+    void applyKeys(const QStringList& keys, bool complete);
+    void publishTickets(const QString& source);
+    void advanceWatermark(const QList<JiraTicket>& tickets);
+    void advanceWatermark(qint64 updatedMs);
+    bool reconcileDue() const;
+    JiraIssueDetails& detailsFor(const QString& issueKey);
+    void indexTicket(qsizetype row);
+    void indexTicket(const QString& issueKey);
+    void applySprint(const QString& issueKey, const JiraIssueFieldSnapshot& fields);
+    void reindexAll();
+    void scheduleSave();
+    void saveCache();
+    void applyFieldEdit(const QString& issueKey, const JiraFieldEdit& edit);
+    void confirmFieldEdit(const QString& issueKey, const JiraFieldEdit& edit);
+    void revertFieldEdit(const QString& issueKey, const JiraFieldEdit& edit);
+    void setFetchedFields(const QString& issueKey, const JiraIssueFieldSnapshot& fields);
+
     JiraClient* m_client;
-    QList<JiraTicket> m_currentTickets;
+    TicketStore m_tickets;
+
+    bool m_deltaSyncEnabled{true};
+    int m_reconcileIntervalSecs{600};
+    QDateTime m_watermark;
+    QDateTime m_lastReconcile;
+
+    QString m_cacheIdentity;
+    QHash<QString, JiraIssueDetails> m_details;
+
+    // Issues with field edits Jira has not confirmed: the last confirmed values, to roll
+    // back to, and which fields have been edited locally.
+    struct PendingFields
+    {
+        JiraIssueFieldSnapshot confirmed;
+        int edited{0};
+    };
+    QHash<QString, PendingFields> m_pendingFields;
+    SearchIndex m_search;
+    QTimer m_saveTimer;
 };
@@ -0,0 +1,52 @@
+#include "fieldcache.h"
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+static QJsonObject readRoot(const QString& path)
+{
+    QFile f(path);
+    if (!f.exists() || !f.open(QIODevice::ReadOnly))
+        return {};
+    const auto doc = QJsonDocument::fromJson(f.readAll());
+    return doc.isObject() ? doc.object() : QJsonObject();
+}
+
+std::optional<FieldCacheEntry> FieldCache::load(const QString& instanceUrl, const QString& path)
+{
+    const auto root = readRoot(path);
+    const auto it = root.constFind(instanceUrl);
+    if (it == root.constEnd() || !it->isObject())
+        return std::nullopt;
+
+    const auto o = it->toObject();
+    FieldCacheEntry e;
+    e.sprintFieldId = o.value("SprintFieldId").toString();
+    e.storyPointsFieldId = o.value("StoryPointsFieldId").toString();
+    e.etag = o.value("ETag").toString();
+    e.lastModified = o.value("LastModified").toString();
+    e.fetched = QDateTime::fromString(o.value("Fetched").toString(), Qt::ISODate);
+    return e;
+}
+
+bool FieldCache::save(const QString& instanceUrl, const FieldCacheEntry& entry, const QString& path)
+{
+    QJsonObject o;
+    o.insert("SprintFieldId", entry.sprintFieldId);
+    o.insert("StoryPointsFieldId", entry.storyPointsFieldId);
+    o.insert("ETag", entry.etag);
+    o.insert("LastModified", entry.lastModified);
+    o.insert("Fetched", entry.fetched.toString(Qt::ISODate));
+
+    // Other instances' entries are kept as they are.
+    auto root = readRoot(path);
+    root.insert(instanceUrl, o);
+
+    QSaveFile out(path);
+    if (!out.open(QIODevice::WriteOnly))
+        return false;
+    out.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    return out.commit();
+}
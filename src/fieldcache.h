@@ -0,0 +1,25 @@
+#pragma once
+
+#include <QDateTime>
+#include <QString>
+
+#include <optional>
+
+// Custom field ids resolved from /rest/api/3/field, plus the validators needed to
+// revalidate them with a conditional GET.
+struct FieldCacheEntry
+{
+    QString sprintFieldId;
+    QString storyPointsFieldId;
+    QString etag;
+    QString lastModified;
+    QDateTime fetched;
+};
+
+// fieldcache.json next to appsettings.json, keyed by instance URL.
+class FieldCache
+{
+public:
+    static std::optional<FieldCacheEntry> load(const QString& instanceUrl, const QString& path = QStringLiteral("fieldcache.json"));
+    static bool save(const QString& instanceUrl, const FieldCacheEntry& entry, const QString& path = QStringLiteral("fieldcache.json"));
+};
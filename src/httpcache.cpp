@@ -0,0 +1,191 @@
+#include "httpcache.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QSaveFile>
+
+#include <algorithm>
+
+static constexpr quint32 kIndexMagic = 0x4A58484C; // "JXHL"
+static constexpr quint16 kIndexVersion = 1;
+
+static QString indexPath(const QString& directory)
+{
+    return QDir(directory).filePath("lru.bin");
+}
+
+HttpCache::HttpCache(const QString& directory, QObject* parent)
+    : QNetworkDiskCache(parent)
+{
+    setCacheDirectory(directory);
+    loadIndex();
+}
+
+HttpCache::~HttpCache()
+{
+    saveIndex();
+}
+
+QIODevice* HttpCache::data(const QUrl& url)
+{
+    QIODevice* device = QNetworkDiskCache::data(url);
+    if (device)
+        touch(url);
+    return device;
+}
+
+QIODevice* HttpCache::prepare(const QNetworkCacheMetaData& metaData)
+{
+    // Without a validator a stored copy could never be confirmed, only re-downloaded.
+    bool hasValidator = false;
+    for (const auto& header : metaData.rawHeaders())
+    {
+        const auto name = header.first.toLower();
+        if (name == "etag" || name == "last-modified")
+        {
+            hasValidator = true;
+            break;
+        }
+    }
+    if (!hasValidator)
+        return nullptr;
+
+    touch(metaData.url());
+    return QNetworkDiskCache::prepare(alwaysRevalidate(metaData));
+}
+
+void HttpCache::updateMetaData(const QNetworkCacheMetaData& metaData)
+{
+    // A 304 refreshes the stored headers, which may carry new freshness information.
+    QNetworkDiskCache::updateMetaData(alwaysRevalidate(metaData));
+}
+
+bool HttpCache::remove(const QUrl& url)
+{
+    m_lastUsed.remove(url);
+    return QNetworkDiskCache::remove(url);
+}
+
+void HttpCache::clear()
+{
+    m_lastUsed.clear();
+    QNetworkDiskCache::clear();
+}
+
+void HttpCache::invalidateIssue(const QString& issueKey)
+{
+    if (issueKey.isEmpty())
+        return;
+
+    const QString marker = "/issue/" + issueKey;
+    QList<QUrl> matches;
+    for (auto it = m_lastUsed.cbegin(); it != m_lastUsed.cend(); ++it)
+    {
+        const QString path = it.key().path();
+        const int at = path.indexOf(marker);
+        if (at < 0)
+            continue;
+        const int end = at + marker.size();
+        if (end == path.size() || path.at(end) == '/')
+            matches.append(it.key());
+    }
+
+    for (const auto& url : matches)
+        remove(url);
+}
+
+QNetworkCacheMetaData HttpCache::alwaysRevalidate(QNetworkCacheMetaData metaData)
+{
+    metaData.setSaveToDisk(true);
+    metaData.setExpirationDate(QDateTime::currentDateTimeUtc());
+    return metaData;
+}
+
+void HttpCache::touch(const QUrl& url)
+{
+    m_lastUsed.insert(url, QDateTime::currentMSecsSinceEpoch());
+}
+
+qint64 HttpCache::expire()
+{
+    struct Item
+    {
+        QString path;
+        QUrl url;
+        qint64 size;
+        qint64 lastUsed;
+    };
+
+    QList<Item> items;
+    qint64 total = 0;
+    QDirIterator it(cacheDirectory(), {QStringLiteral("*.d")}, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext())
+    {
+        it.next();
+        const auto info = it.fileInfo();
+        const QUrl url = fileMetaData(info.filePath()).url();
+        // Entries written before the index existed fall back to their file time.
+        const qint64 lastUsed = m_lastUsed.value(url, info.lastModified().toMSecsSinceEpoch());
+        items.append(Item{info.filePath(), url, info.size(), lastUsed});
+        total += info.size();
+    }
+
+    if (total <= maximumCacheSize())
+        return total;
+
+    // Evict a little below the cap so the next few inserts don't rescan the directory.
+    std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) { return a.lastUsed < b.lastUsed; });
+    const qint64 goal = maximumCacheSize() * 9 / 10;
+    for (const auto& item : items)
+    {
+        if (total <= goal)
+            break;
+        if (QFile::remove(item.path))
+        {
+            total -= item.size;
+            m_lastUsed.remove(item.url);
+        }
+    }
+    return total;
+}
+
+void HttpCache::loadIndex()
+{
+    QFile f(indexPath(cacheDirectory()));
+    if (!f.exists() || !f.open(QIODevice::ReadOnly))
+        return;
+
+    QDataStream in(&f);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint16 version = 0;
+    in >> magic >> version;
+    if (magic != kIndexMagic || version != kIndexVersion)
+        return;
+
+    QHash<QUrl, qint64> index;
+    in >> index;
+    if (in.status() == QDataStream::Ok)
+        m_lastUsed = std::move(index);
+}
+
+void HttpCache::saveIndex() const
+{
+    QDir().mkpath(cacheDirectory());
+    QSaveFile out(indexPath(cacheDirectory()));
+    if (!out.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream s(&out);
+    s.setVersion(QDataStream::Qt_6_0);
+    s << kIndexMagic << kIndexVersion << m_lastUsed;
+    if (s.status() != QDataStream::Ok)
+    {
+        out.cancelWriting();
+        return;
+    }
+    out.commit();
+}
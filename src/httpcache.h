@@ -0,0 +1,41 @@
+#pragma once
+
+#include <QHash>
+#include <QNetworkDiskCache>
+#include <QUrl>
+
+// Disk cache behind JiraClient's QNetworkAccessManager. Jira marks most responses
+// no-store, which would leave QNetworkDiskCache empty; this keeps any GET response that
+// carries a validator (ETag / Last-Modified) but always treats it as stale, so every
+// reuse is a conditional request and an unchanged resource costs a 304 instead of a
+// full body. Eviction is least-recently-used (the base class evicts by file age), with
+// the access times persisted alongside the cache files.
+class HttpCache : public QNetworkDiskCache
+{
+    Q_OBJECT
+public:
+    explicit HttpCache(const QString& directory = QStringLiteral("httpcache"), QObject* parent = nullptr);
+    ~HttpCache() override;
+
+    QIODevice* data(const QUrl& url) override;
+    QIODevice* prepare(const QNetworkCacheMetaData& metaData) override;
+    void updateMetaData(const QNetworkCacheMetaData& metaData) override;
+    bool remove(const QUrl& url) override;
+    void clear() override;
+
+    // Drops every cached response under /issue/{key} (fields, comments, transitions...).
+    // Called after writes: a Last-Modified validator has one-second resolution, so a
+    // read right after an edit could otherwise be answered with a 304.
+    void invalidateIssue(const QString& issueKey);
+
+protected:
+    qint64 expire() override;
+
+private:
+    static QNetworkCacheMetaData alwaysRevalidate(QNetworkCacheMetaData metaData);
+    void touch(const QUrl& url);
+    void loadIndex();
+    void saveIndex() const;
+
+    QHash<QUrl, qint64> m_lastUsed; // msecs since epoch
+};
@@ -0,0 +1,37 @@
+#include "internedstring.h"
+
+#include <QHash>
+#include <QMutex>
+
+const InternedString::Entry* InternedString::intern(const QString& text)
+{
+    // Entries are never freed; the set of distinct values stays small.
+    static QMutex mutex;
+    static QHash<QString, const Entry*> entries;
+    static quint32 nextId = 1;
+
+    QMutexLocker lock(&mutex);
+    auto& slot = entries[text];
+    if (!slot)
+        slot = new Entry{text, nextId++};
+    return slot;
+}
+
+const QString& InternedString::toString() const
+{
+    static const QString empty;
+    return m_entry ? m_entry->text : empty;
+}
+
+QDataStream& operator<<(QDataStream& s, const InternedString& v)
+{
+    return s << v.toString();
+}
+
+QDataStream& operator>>(QDataStream& s, InternedString& v)
+{
+    QString text;
+    s >> text;
+    v = InternedString(text);
+    return s;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QDataStream>
+#include <QHashFunctions>
+#include <QString>
+
+// A string from a small set repeated across many records (status and sprint names,
+// people). Equal strings share one pooled entry for the life of the process, so a record
+// field is one pointer, memory grows with the number of distinct values, and comparing
+// two values compares pointers. The pool is thread-safe; parse jobs intern off the GUI
+// thread.
+class InternedString
+{
+public:
+    InternedString() = default;
+    // Implicit so parsed QStrings can be assigned directly.
+    InternedString(const QString& text) : m_entry(text.isEmpty() ? nullptr : intern(text)) {}
+
+    const QString& toString() const;
+    bool isEmpty() const { return !m_entry; }
+
+    // Dense ids in first-seen order; 0 is the empty string. Good as a bit index.
+    quint32 id() const { return m_entry ? m_entry->id : 0; }
+
+    friend bool operator==(InternedString a, InternedString b) { return a.m_entry == b.m_entry; }
+    friend bool operator!=(InternedString a, InternedString b) { return a.m_entry != b.m_entry; }
+    friend size_t qHash(InternedString s, size_t seed = 0) { return ::qHash(s.id(), seed); }
+
+private:
+    struct Entry
+    {
+        QString text;
+        quint32 id;
+    };
+    static const Entry* intern(const QString& text);
+
+    const Entry* m_entry{nullptr};
+};
+
+// Serialized as the plain string, so files written before interning still load.
+QDataStream& operator<<(QDataStream& s, const InternedString& v);
+QDataStream& operator>>(QDataStream& s, InternedString& v);
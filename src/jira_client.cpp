@@ -1,13 +1,17 @@
 #include "jira_client.h"
+#include "adf.h"
 
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonValue>
 #include <QNetworkReply>
+#include <QThread>
 #include <QUrlQuery>
 
 #include <algorithm>
+#include <memory>
+#include <utility>
 
 static QString toIsoDate(const std::optional<QDate>& d)
 {
@@ -26,9 +30,61 @@ static QString enc(const QString& s)
     return QString::fromUtf8(QUrl::toPercentEncoding(s));
 }
 
+// Jira explains rejected requests in the body ("errorMessages" plus per-field "errors");
+// Qt's errorString only carries the status line.
+static QString jiraErrorText(const QByteArray& data, const QString& fallback)
+{
+    const auto obj = QJsonDocument::fromJson(data).object();
+    QStringList messages;
+    for (const auto& m : obj.value("errorMessages").toArray())
+        messages << m.toString();
+    const auto errors = obj.value("errors").toObject();
+    for (auto it = errors.constBegin(); it != errors.constEnd(); ++it)
+        messages << it.key() + ": " + it.value().toString();
+    messages.removeAll(QString());
+    return messages.isEmpty() ? fallback : messages.join("; ");
+}
+
+static QDateTime parseJiraDateTime(const QString& s)
+{
+    if (s.isEmpty()) return QDateTime();
+    auto dt = QDateTime::fromString(s, Qt::ISODateWithMs);
+    if (!dt.isValid()) dt = QDateTime::fromString(s, Qt::ISODate);
+    if (!dt.isValid() && s.size() > 5 && (s.at(s.size() - 5) == '+' || s.at(s.size() - 5) == '-'))
+    {
+        // Jira emits "+0000" style offsets; Qt's ISO parser wants "+00:00".
+        QString fixed = s;
+        fixed.insert(s.size() - 2, ':');
+        dt = QDateTime::fromString(fixed, Qt::ISODateWithMs);
+    }
+    return dt;
+}
+
 JiraClient::JiraClient(QObject* parent)
     : QObject(parent)
 {
+    // Keep one core for the GUI thread; parse jobs are short and CPU bound.
+    m_parsePool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1));
+
+    // m_net takes ownership.
+    m_httpCache = new HttpCache();
+    m_net.setCache(m_httpCache);
+
+    // Edits are already visible locally, so a short wait costs nothing and lets a burst
+    // of them share one PUT.
+    m_editFlushTimer.setSingleShot(true);
+    m_editFlushTimer.setInterval(750);
+    connect(&m_editFlushTimer, &QTimer::timeout, this, &JiraClient::flushFieldEdits);
+}
+
+void JiraClient::setHttpCacheSize(qint64 maxBytes)
+{
+    m_httpCache->setMaximumCacheSize(std::max<qint64>(1024 * 1024, maxBytes));
+}
+
+void JiraClient::invalidateIssueCache(const QString& issueKey)
+{
+    m_httpCache->invalidateIssue(issueKey);
 }
 
 void JiraClient::configure(const QString& instanceUrl, const QString& username, const QString& apiToken)
@@ -39,8 +95,27 @@ void JiraClient::configure(const QString& instanceUrl, const QString& username,
     m_basePlatform = m_instanceUrl + "/rest/api/3";
     m_baseAgile = m_instanceUrl + "/rest/agile/1.0";
     m_fieldMetadataLoaded = false;
+    m_fieldMetadataRevalidated = false;
+    ++m_fieldMetadataGeneration;
     m_sprintFieldId.clear();
     m_storyPointsFieldId.clear();
+    m_fieldCache = FieldCacheEntry{};
+    if (const auto stored = FieldCache::load(m_instanceUrl))
+    {
+        m_fieldCache = *stored;
+        m_sprintFieldId = stored->sprintFieldId;
+        m_storyPointsFieldId = stored->storyPointsFieldId;
+        m_fieldMetadataLoaded = true;
+    }
+
+    const QString identity = m_instanceUrl + "|" + username.trimmed();
+    // Cached bodies were fetched with another account's permissions.
+    if (!m_agileCacheIdentity.isEmpty() && identity != m_agileCacheIdentity)
+        m_httpCache->clear();
+
+    m_agileCacheIdentity = identity;
+    m_agileCache.clear();
+    m_agileCache.load(m_agileCacheIdentity);
 }
 
 QByteArray JiraClient::authHeader() const
@@ -68,452 +143,771 @@ bool JiraClient::isAuthError(const QNetworkReply* reply, QNetworkReply::NetworkE
         || status == 403;
 }
 
-void JiraClient::ensureFieldMetadata(std::function<void()> cont)
+void JiraClient::dispatch(Lane lane,
+                          RequestTracer::EndpointStats& endpoint,
+                          std::function<QNetworkReply*()> send,
+                          std::function<void(QNetworkReply*)> onFinished,
+                          const QString& tag,
+                          std::function<void()> onDropped)
 {
-    if (m_fieldMetadataLoaded)
-    {
-        cont();
-        return;
-    }
-
-    const QUrl url(m_basePlatform + "/field");
-    QNetworkReply* reply = m_net.get(makeRequest(url));
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, cont]() {
-        const auto guard = QPointer<QNetworkReply>(reply);
-        const auto data = reply->readAll();
-        const auto err = reply->error();
-        const auto errStr = reply->errorString();
-        reply->deleteLater();
+    auto request = std::make_shared<const PendingRequest>(
+        PendingRequest{lane, &endpoint, std::move(send), std::move(onFinished), tag, std::move(onDropped)});
+    enqueueAttempt(std::move(request), 0, 0);
+}
 
-        if (err != QNetworkReply::NoError)
-        {
-            if (isAuthError(reply, err))
+void JiraClient::enqueueAttempt(std::shared_ptr<const PendingRequest> request, int attempt, int delayMs)
+{
+    const qint64 enqueued = m_tracer.now() + qint64(delayMs) * 1000;
+    auto start = [this, request, attempt, enqueued]() -> QNetworkReply* {
+        QNetworkReply* reply = request->send();
+        if (!reply)
+            return nullptr;
+        if (attempt == 0)
+            m_retryPolicy.recordRequest();
+
+        const bool interactive = request->lane == Lane::Interactive;
+        // Tracer first, so its finished handler stamps the end before onFinished runs.
+        m_tracer.attach(reply, *request->endpoint,
+            interactive ? QStringLiteral("interactive") : QStringLiteral("background"), enqueued, attempt);
+        QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request, attempt, interactive]() {
+            const auto decision = m_retryPolicy.evaluate(reply, attempt, interactive);
+            if (!decision.retry)
             {
-                emit authenticationRequired("Jira authentication failed while loading field metadata. Please configure your API token.");
+                request->onFinished(reply);
                 return;
             }
-            emit operationFailed("Load field metadata", errStr);
-            cont();
-            return;
-        }
-
-        const auto doc = QJsonDocument::fromJson(data);
-        if (!doc.isArray())
-        {
-            emit operationFailed("Load field metadata", "Unexpected JSON (expected array)");
-            cont();
-            return;
-        }
-
-        const auto arr = doc.array();
-        for (const auto& v : arr)
-        {
-            const auto o = v.toObject();
-            const auto name = o.value("name").toString();
-            const auto id = o.value("id").toString();
-            if (name.compare("Sprint", Qt::CaseInsensitive) == 0)
-                m_sprintFieldId = id;
-            if (name.compare("Story Points", Qt::CaseInsensitive) == 0)
-                m_storyPointsFieldId = id;
-        }
-
-        m_fieldMetadataLoaded = true;
-        cont();
-    });
+            // The limit is per account, so every queued request would hit it too.
+            if (decision.rateLimited)
+                m_scheduler.pauseFor(decision.delayMs);
+            reply->deleteLater();
+            enqueueAttempt(request, attempt + 1, decision.delayMs);
+        });
+        return reply;
+    };
+    m_scheduler.enqueueAfter(delayMs, request->lane, std::move(start), request->tag, request->onDropped);
 }
 
-void JiraClient::getMyTickets()
+bool JiraClient::isStale(const Call& call) const
 {
-    // Mirrors C# MyTicketJql and pagination via nextPageToken.
-    const QString jql = "assignee = currentUser() and status NOT IN (Closed, Done) ORDER BY updated DESC";
-    const int maxResults = 1000;
-
-    ensureFieldMetadata([this, jql, maxResults]() {
-        QList<JiraTicket> all;
-
-        // We implement pagination by recursively requesting with nextPageToken.
-        std::function<void(const QString&)> fetchPage;
-        fetchPage = [this, &all, jql, maxResults, &fetchPage](const QString& nextPageToken) {
-            QUrl url(m_basePlatform + "/search/jql");
-
-            QJsonObject body;
-            body.insert("jql", jql);
-            body.insert("maxResults", maxResults);
+    return !call.issueKey.isEmpty() && isStale(call.issueKey, call.generation);
+}
 
-            QJsonArray fields;
-            fields.append("key");
-            fields.append("summary");
-            fields.append("status");
-            fields.append("updated");
-            if (!m_sprintFieldId.isEmpty())
-                fields.append(m_sprintFieldId);
-            body.insert("fields", fields);
+template <typename T>
+void JiraClient::request(const Call& call,
+                         std::function<QNetworkReply*()> send,
+                         std::function<std::optional<T>(const QByteArray&)> parse,
+                         std::function<void(const Response<T>&)> done,
+                         std::function<void(const QByteArray&)> received)
+{
+    const auto cancelled = [done]() {
+        Response<T> r;
+        r.outcome = Outcome::Cancelled;
+        done(r);
+    };
 
-            if (!nextPageToken.isEmpty())
-                body.insert("nextPageToken", nextPageToken);
+    // Resolved once here; every sample of this request then only touches atomics.
+    auto* stats = &m_tracer.endpoint(call.endpoint);
+    dispatch(call.lane, *stats,
+        [this, call, send]() -> QNetworkReply* {
+            if (call.issueKey.isEmpty())
+                return send();
+            if (isStale(call))
+                return nullptr; // deselected while queued
+            QNetworkReply* reply = send();
+            trackIssueReply(call.issueKey, reply);
+            return reply;
+        },
+        [this, call, stats, parse, done, received](QNetworkReply* reply) {
+            Response<T> r;
+            const auto data = reply->readAll();
+            const auto err = reply->error();
+            const auto errStr = reply->errorString();
+            r.httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+            r.etag = reply->rawHeader("ETag");
+            r.lastModified = reply->rawHeader("Last-Modified");
+            reply->deleteLater();
 
-            const auto payload = QJsonDocument(body).toJson(QJsonDocument::Compact);
-            QNetworkReply* reply = m_net.post(makeRequest(url), payload);
+            const QString context = call.context.isEmpty() ? call.endpoint : call.context;
 
-            QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, &all, fetchPage]() mutable {
-                const auto data = reply->readAll();
-                const auto err = reply->error();
-                const auto errStr = reply->errorString();
-                reply->deleteLater();
+            if (err == QNetworkReply::OperationCanceledError || isStale(call))
+            {
+                r.outcome = Outcome::Cancelled; // superseded by setActiveIssue() or a newer request
+                done(r);
+                return;
+            }
 
-                if (err != QNetworkReply::NoError)
+            if (err != QNetworkReply::NoError)
+            {
+                if (isAuthError(reply, err))
                 {
-                    if (isAuthError(reply, err))
-                    {
-                        emit authenticationRequired("Jira authentication failed while loading tickets. Please configure your API token.");
-                        emit myTicketsReady({});
-                        return;
-                    }
-                    emit operationFailed("GetMyTickets", errStr);
-                    emit myTicketsReady(all);
+                    if (!call.authAction.isEmpty())
+                        emit authenticationRequired(QString("Jira authentication failed while %1. Please configure your API token.").arg(call.authAction));
+                    r.outcome = Outcome::AuthFailed;
+                    done(r);
                     return;
                 }
+                r.error = jiraErrorText(data, errStr);
+                if (call.reportErrors)
+                    emit operationFailed(context, r.error);
+                done(r);
+                return;
+            }
 
-                const auto doc = QJsonDocument::fromJson(data);
-                if (!doc.isObject())
-                {
-                    emit operationFailed("GetMyTickets", "Unexpected JSON (expected object)");
-                    emit myTicketsReady(all);
-                    return;
-                }
+            if (r.httpStatus == 304)
+            {
+                r.outcome = Outcome::NotModified;
+                done(r);
+                return;
+            }
 
-                const auto root = doc.object();
-                const auto issues = root.value("issues").toArray();
-                for (const auto& v : issues)
-                {
-                    const auto issue = v.toObject();
-                    const auto key = issue.value("key").toString();
-                    const auto fields = issue.value("fields").toObject();
-                    const auto summary = fields.value("summary").toString();
+            if (!parse)
+            {
+                r.outcome = Outcome::Ok;
+                done(r);
+                return;
+            }
 
-                    QString status;
-                    const auto statusObj = fields.value("status").toObject();
-                    status = statusObj.value("name").toString();
+            if (received)
+                received(data);
 
-                    QString sprintName = "No Sprint";
-                    if (!m_sprintFieldId.isEmpty() && fields.contains(m_sprintFieldId))
+            parseAsync(*stats, [parse, data]() { return parse(data); })
+                .then(this, [this, call, context, done, r](std::optional<T> value) mutable {
+                    if (isStale(call))
                     {
-                        const auto sprintVal = fields.value(m_sprintFieldId);
-                        if (sprintVal.isArray() && !sprintVal.toArray().isEmpty())
-                        {
-                            const auto first = sprintVal.toArray().first();
-                            if (first.isObject())
-                                sprintName = first.toObject().value("name").toString("Sprint");
-                            else if (first.isString())
-                                sprintName = first.toString();
-                        }
-                        else if (sprintVal.isObject())
-                        {
-                            sprintName = sprintVal.toObject().value("name").toString("Sprint");
-                        }
-                        else if (sprintVal.isString())
-                        {
-                            sprintName = sprintVal.toString();
-                        }
+                        r.outcome = Outcome::Cancelled;
+                        done(r);
+                        return;
                     }
+                    if (!value)
+                    {
+                        r.error = QStringLiteral("Unexpected JSON response");
+                        if (call.reportErrors)
+                            emit operationFailed(context, r.error);
+                        done(r);
+                        return;
+                    }
+                    r.outcome = Outcome::Ok;
+                    r.value = std::move(value);
+                    done(r);
+                });
+        },
+        call.tag, cancelled);
+}
 
-                    all.append(JiraTicket{key, summary, status, sprintName});
-                }
-
-                const auto token = root.value("nextPageToken").toString();
-                if (!token.isEmpty())
-                {
-                    fetchPage(token);
-                    return;
-                }
-
-                emit myTicketsReady(all);
-            });
-        };
+template <typename Item>
+void JiraClient::paginate(const Call& call,
+                          std::function<QNetworkReply*(const PageCursor&)> send,
+                          std::function<std::optional<Page<Item>>(const QByteArray&, const PageCursor&)> parse,
+                          std::function<void(const QList<Item>&)> onPage,
+                          std::function<void(Outcome)> onDone,
+                          std::function<std::optional<PageCursor>(const QByteArray&)> peek)
+{
+    // Owned by the requests in flight; released when the last of them is done.
+    auto pager = std::make_shared<Pager<Item>>();
+    pager->call = call;
+    pager->send = std::move(send);
+    pager->parse = std::move(parse);
+    pager->peek = std::move(peek);
+    pager->onPage = std::move(onPage);
+    pager->onDone = std::move(onDone);
+    requestPage(std::move(pager), 0, PageCursor{});
+}
 
-        fetchPage(QString());
-    });
+template <typename Item>
+void JiraClient::requestPage(std::shared_ptr<Pager<Item>> pager, int index, const PageCursor& at)
+{
+    const quint64 epoch = pager->epoch;
+    pager->cursors.insert(index, at);
+    pager->issued = index + 1;
+    ++pager->inFlight;
+
+    request<Page<Item>>(pager->call,
+        [pager, at]() { return pager->send(at); },
+        [pager, at](const QByteArray& data) { return pager->parse(data, at); },
+        [this, pager, index, epoch](const Response<Page<Item>>& r) {
+            --pager->inFlight;
+            if (pager->finished || epoch != pager->epoch)
+                return;
+            if (r.outcome != Outcome::Ok)
+            {
+                pager->finished = true;
+                pager->onDone(r.outcome);
+                return;
+            }
+            pager->arrived.insert(index, *r.value);
+            deliverPages(pager);
+        },
+        [this, pager, index, epoch](const QByteArray& data) {
+            // Only the newest page may look ahead, and only one page.
+            if (!pager->peek || pager->finished || epoch != pager->epoch || pager->issued != index + 1)
+                return;
+            if (const auto next = pager->peek(data))
+                requestPage(pager, index + 1, *next);
+        });
 }
 
-void JiraClient::getIssueFieldSnapshot(const QString& issueKey)
+template <typename Item>
+void JiraClient::deliverPages(std::shared_ptr<Pager<Item>> pager)
 {
-    if (issueKey.trimmed().isEmpty())
+    while (!pager->finished && pager->arrived.contains(pager->delivered))
     {
-        emit issueFieldSnapshotReady(JiraIssueFieldSnapshot{});
-        return;
-    }
+        const int index = pager->delivered++;
+        const Page<Item> page = pager->arrived.take(index);
+        pager->onPage(page.items);
 
-    ensureFieldMetadata([this, issueKey]() {
-        // fields: description, assignee, duedate, story points (custom), sprint (custom)
-        QStringList fields;
-        fields << "description" << "assignee" << "duedate";
-        if (!m_storyPointsFieldId.isEmpty()) fields << m_storyPointsFieldId;
-        if (!m_sprintFieldId.isEmpty()) fields << m_sprintFieldId;
+        if (!page.next)
+            continue;
 
-        const QString fieldsParam = fields.join(',');
-        QUrl url(m_basePlatform + "/issue/" + enc(issueKey));
-        QUrlQuery q;
-        q.addQueryItem("fields", fieldsParam);
-        url.setQuery(q);
+        if (index == 0 && page.next->token.isEmpty() && page.total >= 0 && page.step > 0)
+        {
+            for (int start = page.next->startAt; start < page.total; start += page.step)
+                pager->planned.append(PageCursor{start, QString()});
+            continue;
+        }
 
-        QNetworkReply* reply = m_net.get(makeRequest(url));
-        QObject::connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-            const auto data = reply->readAll();
-            const auto err = reply->error();
-            const auto errStr = reply->errorString();
-            reply->deleteLater();
+        if (pager->issued > index + 1)
+        {
+            // A prefetched token page must be the one the server pointed at; otherwise
+            // drop it and everything after it.
+            if (page.next->token.isEmpty() || pager->cursors.value(index + 1).token == page.next->token)
+                continue;
+            ++pager->epoch;
+            pager->arrived.clear();
+        }
+        else if (!pager->planned.isEmpty())
+        {
+            continue; // the rest of the plan is on its way
+        }
+        // Sequential step: no `total`, no peek, or the listing grew past the plan.
+        requestPage(pager, index + 1, *page.next);
+    }
 
-            if (err != QNetworkReply::NoError)
-            {
-                if (isAuthError(reply, err))
-                {
-                    emit authenticationRequired("Jira authentication failed while loading issue details. Please configure your API token.");
-                    emit issueFieldSnapshotReady(JiraIssueFieldSnapshot{});
-                    return;
-                }
-                emit operationFailed("GetIssueFieldSnapshot", errStr);
-                emit issueFieldSnapshotReady(JiraIssueFieldSnapshot{});
-                return;
-            }
+    while (!pager->finished && !pager->planned.isEmpty() && pager->inFlight < kMaxPagesInFlight)
+        requestPage(pager, pager->issued, pager->planned.takeFirst());
 
-            const auto doc = QJsonDocument::fromJson(data);
-            if (!doc.isObject())
-            {
-                emit operationFailed("GetIssueFieldSnapshot", "Unexpected JSON (expected object)");
-                emit issueFieldSnapshotReady(JiraIssueFieldSnapshot{});
-                return;
-            }
+    if (!pager->finished && pager->planned.isEmpty() && pager->delivered == pager->issued)
+    {
+        pager->finished = true;
+        pager->onDone(Outcome::Ok);
+    }
+}
 
-            const auto root = doc.object();
-            const auto fieldsObj = root.value("fields").toObject();
+void JiraClient::write(const Call& call, const QString& issueKey, std::function<QNetworkReply*()> send,
+                       const QString& successMessage, std::function<void()> then)
+{
+    request<std::monostate>(call, std::move(send), {}, [this, issueKey, successMessage, then](const Response<std::monostate>& r) {
+        if (r.outcome != Outcome::Ok)
+            return;
+        m_httpCache->invalidateIssue(issueKey);
+        emit operationSucceeded(successMessage);
+        if (then)
+            then();
+    });
+}
 
-            JiraIssueFieldSnapshot snap;
+void JiraClient::stageFieldEdit(const QString& issueKey, const JiraFieldEdit& edit, const QJsonObject& fields)
+{
+    auto& staged = m_stagedEdits[issueKey];
+    staged.edit.merge(edit);
+    for (auto it = fields.constBegin(); it != fields.constEnd(); ++it)
+        staged.fields.insert(it.key(), it.value());
 
-            // Description (ADF)
-            const auto desc = fieldsObj.value("description");
-            if (!desc.isNull() && !desc.isUndefined())
-                snap.description = adfToPlainText(desc);
+    emit issueFieldsEdited(issueKey, edit);
+    m_editFlushTimer.start();
+}
 
-            // Story points
-            if (!m_storyPointsFieldId.isEmpty())
-            {
-                const auto sp = fieldsObj.value(m_storyPointsFieldId);
-                if (sp.isDouble()) snap.storyPoints = sp.toDouble();
-            }
+void JiraClient::flushFieldEdits()
+{
+    m_editFlushTimer.stop();
+    const auto keys = m_stagedEdits.keys();
+    for (const auto& key : keys)
+        if (!m_sendingEdits.contains(key))
+            sendFieldEdits(key);
+}
 
-            // Assignee
-            const auto assignee = fieldsObj.value("assignee");
-            if (assignee.isObject())
-            {
-                const auto ao = assignee.toObject();
-                snap.assigneeDisplayName = ao.value("displayName").toString();
-                snap.assigneeAccountId = ao.value("accountId").toString();
-            }
+void JiraClient::sendFieldEdits(const QString& issueKey)
+{
+    const StagedEdit staged = m_stagedEdits.take(issueKey);
+    if (staged.edit.isEmpty())
+        return;
+    m_sendingEdits.insert(issueKey, staged.edit);
 
-            // Due date
-            const auto due = fieldsObj.value("duedate").toString();
-            if (!due.isEmpty())
+    QJsonObject payload;
+    payload.insert("fields", staged.fields);
+    const auto body = QJsonDocument(payload).toJson(QJsonDocument::Compact);
+    const QUrl url(m_basePlatform + "/issue/" + enc(issueKey));
+
+    request<std::monostate>(
+        Call{.endpoint = "UpdateFields", .authAction = "updating the issue"},
+        [this, url, body]() { return m_net.put(makeRequest(url), body); },
+        {},
+        [this, issueKey](const Response<std::monostate>& r) {
+            const JiraFieldEdit sent = m_sendingEdits.take(issueKey);
+            if (r.outcome == Outcome::Ok)
             {
-                const auto d = QDate::fromString(due, Qt::ISODate);
-                if (d.isValid()) snap.dueDate = d;
+                m_httpCache->invalidateIssue(issueKey);
+                emit issueFieldsSaved(issueKey, sent);
+                if ((sent.fields & JiraFieldEdit::Sprint) && sent.values.sprintId.has_value() && sent.values.sprintName.isEmpty())
+                    getIssueFieldSnapshot(issueKey);
+
+                static const QHash<int, QString> kMessages{
+                    {JiraFieldEdit::Description, QStringLiteral("Description updated")},
+                    {JiraFieldEdit::StoryPoints, QStringLiteral("Story points updated")},
+                    {JiraFieldEdit::Assignee, QStringLiteral("Assignee updated")},
+                    {JiraFieldEdit::Sprint, QStringLiteral("Sprint updated")},
+                    {JiraFieldEdit::DueDate, QStringLiteral("Due date updated")},
+                };
+                emit operationSucceeded(kMessages.value(sent.fields, QStringLiteral("Fields updated")));
             }
-
-            // Sprint
-            if (!m_sprintFieldId.isEmpty())
+            else
             {
-                const auto sprintVal = fieldsObj.value(m_sprintFieldId);
-                if (sprintVal.isArray() && !sprintVal.toArray().isEmpty())
-                {
-                    const auto first = sprintVal.toArray().first();
-                    extractSprint(first, snap.sprintId, snap.sprintName);
-                    if (snap.sprintName.isEmpty() && first.isString())
-                        snap.sprintName = parseSprintNameFromLegacyString(first.toString());
-                }
-                else if (sprintVal.isObject())
-                {
-                    extractSprint(sprintVal, snap.sprintId, snap.sprintName);
-                }
-                else if (sprintVal.isString())
-                {
-                    snap.sprintName = parseSprintNameFromLegacyString(sprintVal.toString());
-                }
+                JiraFieldEdit revert = sent;
+                revert.fields &= ~m_stagedEdits.value(issueKey).edit.fields;
+                if (!revert.isEmpty())
+                    emit issueFieldsReverted(issueKey, revert);
             }
 
-            emit issueFieldSnapshotReady(snap);
+            // Edits made meanwhile waited for this one, so they land in order.
+            if (m_stagedEdits.contains(issueKey) && !m_editFlushTimer.isActive())
+                sendFieldEdits(issueKey);
         });
+}
+
+void JiraClient::overlayFieldEdits(const QString& issueKey, JiraIssueFieldSnapshot& snapshot) const
+{
+    const auto sending = m_sendingEdits.constFind(issueKey);
+    if (sending != m_sendingEdits.constEnd())
+        sending->applyTo(snapshot);
+    const auto staged = m_stagedEdits.constFind(issueKey);
+    if (staged != m_stagedEdits.constEnd())
+        staged->edit.applyTo(snapshot);
+}
+
+void JiraClient::setActiveIssue(const QString& issueKey)
+{
+    if (issueKey == m_activeIssueKey)
+        return;
+    m_activeIssueKey = issueKey;
+
+    // Abort whatever is still downloading for previously selected issues; their
+    // handlers see OperationCanceledError and return quietly.
+    for (auto it = m_issueReplies.begin(); it != m_issueReplies.end();)
+    {
+        if (it.key() == issueKey)
+        {
+            ++it;
+            continue;
+        }
+        const auto replies = it.value();
+        it = m_issueReplies.erase(it);
+        for (const auto& r : replies)
+            if (r) r->abort();
+    }
+}
+
+void JiraClient::trackIssueReply(const QString& issueKey, QNetworkReply* reply)
+{
+    m_issueReplies[issueKey].append(QPointer<QNetworkReply>(reply));
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, issueKey, reply]() {
+        auto it = m_issueReplies.find(issueKey);
+        if (it == m_issueReplies.end())
+            return;
+        it->removeIf([reply](const QPointer<QNetworkReply>& r) { return !r || r == reply; });
+        if (it->isEmpty())
+            m_issueReplies.erase(it);
     });
 }
 
-void JiraClient::getIssueComments(const QString& issueKey)
+bool JiraClient::isStale(const QString& issueKey, quint64 generation) const
 {
-    if (issueKey.trimmed().isEmpty())
+    if (!m_activeIssueKey.isEmpty() && issueKey != m_activeIssueKey)
+        return true;
+    return generation != 0 && generation != m_issueGenerations.value(issueKey);
+}
+
+void JiraClient::ensureFieldMetadata(std::function<void()> cont)
+{
+    if (m_fieldMetadataLoaded)
     {
-        emit issueCommentsReady({});
+        // Ids persisted from an earlier session are used right away and checked against
+        // the server in the background once per session.
+        if (!m_fieldMetadataRevalidated)
+            fetchFieldMetadata();
+        cont();
         return;
     }
 
-    QList<JiraComment> all;
-    const int maxResults = 50;
+    // Callers arriving while the GET is in flight wait for that one instead of issuing
+    // their own.
+    m_fieldMetadataWaiters.append(std::move(cont));
+    fetchFieldMetadata();
+}
 
-    std::function<void(int)> fetch;
-    fetch = [this, issueKey, maxResults, &all, &fetch](int startAt) {
-        QUrl url(m_basePlatform + "/issue/" + enc(issueKey) + "/comment");
-        QUrlQuery q;
-        q.addQueryItem("startAt", QString::number(startAt));
-        q.addQueryItem("maxResults", QString::number(maxResults));
-        url.setQuery(q);
+void JiraClient::fetchFieldMetadata()
+{
+    if (m_fieldMetadataInFlight)
+        return;
 
-        QNetworkReply* reply = m_net.get(makeRequest(url));
-        QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, startAt, maxResults, &all, fetch]() mutable {
-            const auto data = reply->readAll();
-            const auto err = reply->error();
-            const auto errStr = reply->errorString();
-            reply->deleteLater();
+    // Without validators a revalidation would re-download the whole array, so fall back
+    // to a plain age limit in that case.
+    const bool revalidating = m_fieldMetadataLoaded;
+    const bool hasValidators = !m_fieldCache.etag.isEmpty() || !m_fieldCache.lastModified.isEmpty();
+    m_fieldMetadataRevalidated = true;
+    if (revalidating && !hasValidators
+        && m_fieldCache.fetched.isValid() && m_fieldCache.fetched.daysTo(QDateTime::currentDateTimeUtc()) < 7)
+        return;
 
-            if (err != QNetworkReply::NoError)
-            {
-                if (isAuthError(reply, err))
-                {
-                    emit authenticationRequired("Jira authentication failed while loading comments. Please configure your API token.");
-                    emit issueCommentsReady({});
-                    return;
-                }
-                emit operationFailed("GetIssueComments", errStr);
-                emit issueCommentsReady(all);
-                return;
-            }
+    m_fieldMetadataInFlight = true;
+    const quint64 generation = m_fieldMetadataGeneration;
 
-            const auto doc = QJsonDocument::fromJson(data);
-            if (!doc.isObject())
-            {
-                emit operationFailed("GetIssueComments", "Unexpected JSON (expected object)");
-                emit issueCommentsReady(all);
-                return;
-            }
+    // Validated by hand against the persisted ids, so bypass the HTTP cache.
+    QNetworkRequest req = makeRequest(QUrl(m_basePlatform + "/field"));
+    req.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+    req.setAttribute(QNetworkRequest::CacheSaveControlAttribute, false);
+    if (revalidating)
+    {
+        if (!m_fieldCache.etag.isEmpty())
+            req.setRawHeader("If-None-Match", m_fieldCache.etag.toUtf8());
+        if (!m_fieldCache.lastModified.isEmpty())
+            req.setRawHeader("If-Modified-Since", m_fieldCache.lastModified.toUtf8());
+    }
 
-            const auto root = doc.object();
-            const auto comments = root.value("comments").toArray();
-            if (comments.isEmpty())
+    const Call call{
+        .lane = revalidating ? Lane::Background : Lane::Interactive,
+        .endpoint = "GetFields",
+        .context = "Load field metadata",
+        // A failed revalidation keeps the persisted ids without bothering the user.
+        .authAction = revalidating ? QString() : QStringLiteral("loading field metadata"),
+        .reportErrors = !revalidating,
+    };
+    request<FieldIds>(call, [this, req]() { return m_net.get(req); }, &JiraClient::parseFieldMetadata,
+        [this, generation, revalidating](const Response<FieldIds>& r) {
+            if (generation != m_fieldMetadataGeneration)
             {
-                emit issueCommentsReady(all);
+                // configure() switched instances meanwhile; start over for the waiters.
+                m_fieldMetadataInFlight = false;
+                if (!m_fieldMetadataWaiters.isEmpty())
+                    fetchFieldMetadata();
                 return;
             }
 
-            for (const auto& v : comments)
+            if (r.outcome == Outcome::AuthFailed && !revalidating)
             {
-                const auto c = v.toObject();
-                JiraComment jc;
-                jc.id = c.value("id").toString();
-                const auto authorObj = c.value("author").toObject();
-                jc.author = authorObj.value("displayName").toString();
-                const auto createdStr = c.value("created").toString();
-                jc.created = QDateTime::fromString(createdStr, Qt::ISODateWithMs);
-                if (!jc.created.isValid())
-                    jc.created = QDateTime::fromString(createdStr, Qt::ISODate);
-
-                const auto body = c.value("body");
-                QString bodyText;
-                if (body.isString()) bodyText = body.toString();
-                else bodyText = adfToPlainText(body);
-                jc.editableBody = bodyText;
-                all.append(jc);
+                m_fieldMetadataInFlight = false;
+                m_fieldMetadataWaiters.clear();
+                return;
             }
 
-            const int total = root.value("total").toInt(startAt + comments.size());
-            const int nextStart = startAt + comments.size();
-            if (nextStart >= total)
+            if (r.outcome == Outcome::Ok)
             {
-                emit issueCommentsReady(all);
-                return;
+                m_sprintFieldId = r.value->sprint;
+                m_storyPointsFieldId = r.value->storyPoints;
+                m_fieldMetadataLoaded = true;
+
+                m_fieldCache = FieldCacheEntry{r.value->sprint, r.value->storyPoints,
+                                               QString::fromUtf8(r.etag), QString::fromUtf8(r.lastModified),
+                                               QDateTime::currentDateTimeUtc()};
+                FieldCache::save(m_instanceUrl, m_fieldCache);
             }
 
-            fetch(nextStart);
+            // Runs the callers that waited on this request (if any). After a 304 or a failed
+            // revalidation they keep the persisted ids.
+            m_fieldMetadataInFlight = false;
+            const auto waiters = std::exchange(m_fieldMetadataWaiters, {});
+            for (const auto& w : waiters)
+                w();
         });
-    };
+}
+
+// Mirrors C# MyTicketJql. The delta and keys-only variants narrow the same predicate.
+static const QString kMyTicketsFilter = QStringLiteral("assignee = currentUser() and status NOT IN (Closed, Done)");
 
-    fetch(0);
+void JiraClient::getMyTickets()
+{
+    const QString jql = kMyTicketsFilter + " ORDER BY updated DESC";
+    const int maxResults = 1000;
+
+    ensureFieldMetadata([this, jql, maxResults]() {
+        auto all = std::make_shared<QList<JiraTicket>>();
+        searchTickets(Lane::Interactive, jql, ticketSearchFields(), maxResults, "GetMyTickets",
+            [this, all](const QList<JiraTicket>& page) {
+                all->append(page);
+                emit myTicketsPage(page);
+            },
+            [this, all](bool complete, bool authFailed) {
+                if (authFailed)
+                {
+                    emit authenticationRequired("Jira authentication failed while loading tickets. Please configure your API token.");
+                    emit myTicketsReady({}, false);
+                    return;
+                }
+                emit myTicketsReady(*all, complete);
+            });
+    });
 }
 
-void JiraClient::getIssueHistory(const QString& issueKey)
+void JiraClient::getMyTicketsUpdatedSince(const QDateTime& since)
 {
-    if (issueKey.trimmed().isEmpty())
+    if (!since.isValid())
     {
-        emit issueHistoryReady({});
+        getMyTickets();
         return;
     }
 
-    QUrl url(m_basePlatform + "/issue/" + enc(issueKey));
-    QUrlQuery q;
-    q.addQueryItem("expand", "changelog");
-    q.addQueryItem("fields", "summary");
-    url.setQuery(q);
+    // Relative JQL dates sidestep the user's profile timezone; JQL only has minute
+    // precision, so round up and add a little slack for clock skew.
+    const qint64 secs = std::max<qint64>(0, since.secsTo(QDateTime::currentDateTimeUtc()));
+    const qint64 minutes = secs / 60 + 2;
+    const QString jql = QString("%1 and updated >= -%2m ORDER BY updated DESC").arg(kMyTicketsFilter).arg(minutes);
+    const int maxResults = 1000;
 
-    QNetworkReply* reply = m_net.get(makeRequest(url));
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-        const auto data = reply->readAll();
-        const auto err = reply->error();
-        const auto errStr = reply->errorString();
-        reply->deleteLater();
+    ensureFieldMetadata([this, jql, maxResults]() {
+        auto all = std::make_shared<QList<JiraTicket>>();
+        searchTickets(Lane::Interactive, jql, ticketSearchFields(), maxResults, "GetMyTicketsDelta",
+            [all](const QList<JiraTicket>& page) {
+                all->append(page);
+            },
+            [this, all](bool complete, bool authFailed) {
+                if (authFailed)
+                {
+                    emit authenticationRequired("Jira authentication failed while loading tickets. Please configure your API token.");
+                    emit myTicketsDeltaReady({}, false);
+                    return;
+                }
+                emit myTicketsDeltaReady(*all, complete);
+            });
+    });
+}
 
-        if (err != QNetworkReply::NoError)
-        {
-            if (isAuthError(reply, err))
+void JiraClient::getMyTicketKeys()
+{
+    const QString jql = kMyTicketsFilter;
+    // Search pages can be much larger when no fields beyond the key are requested.
+    const int maxResults = 5000;
+
+    QJsonArray fields;
+    fields.append("key");
+
+    auto keys = std::make_shared<QStringList>();
+    // Reconciles are housekeeping; let detail loads go first.
+    searchTickets(Lane::Background, jql, fields, maxResults, "GetMyTicketKeys",
+        [keys](const QList<JiraTicket>& page) {
+            for (const auto& t : page)
+                keys->append(t.key);
+        },
+        [this, keys](bool complete, bool authFailed) {
+            if (authFailed)
             {
-                emit authenticationRequired("Jira authentication failed while loading history. Please configure your API token.");
-                emit issueHistoryReady({});
+                emit authenticationRequired("Jira authentication failed while loading tickets. Please configure your API token.");
+                emit myTicketKeysReady({}, false);
                 return;
             }
-            emit operationFailed("GetIssueHistory", errStr);
-            emit issueHistoryReady({});
-            return;
-        }
+            emit myTicketKeysReady(*keys, complete);
+        });
+}
 
-        const auto doc = QJsonDocument::fromJson(data);
-        if (!doc.isObject())
-        {
-            emit operationFailed("GetIssueHistory", "Unexpected JSON (expected object)");
-            emit issueHistoryReady({});
+QJsonArray JiraClient::ticketSearchFields() const
+{
+    QJsonArray fields;
+    fields.append("key");
+    fields.append("summary");
+    fields.append("status");
+    fields.append("updated");
+    if (!m_sprintFieldId.isEmpty())
+        fields.append(m_sprintFieldId);
+    return fields;
+}
+
+void JiraClient::searchTickets(Lane lane,
+                               const QString& jql,
+                               const QJsonArray& fields,
+                               int maxResults,
+                               const QString& context,
+                               std::function<void(const QList<JiraTicket>&)> onPage,
+                               std::function<void(bool, bool)> onDone)
+{
+    const QUrl url(m_basePlatform + "/search/jql");
+    const auto sprintFieldId = m_sprintFieldId;
+
+    paginate<JiraTicket>(Call{.lane = lane, .endpoint = context},
+        [this, url, jql, fields, maxResults](const PageCursor& at) {
+            QJsonObject body;
+            body.insert("jql", jql);
+            body.insert("maxResults", maxResults);
+            body.insert("fields", fields);
+            if (!at.token.isEmpty())
+                body.insert("nextPageToken", at.token);
+
+            QNetworkRequest req = makeRequest(url);
+            RetryPolicy::markIdempotent(req);
+            return m_net.post(req, QJsonDocument(body).toJson(QJsonDocument::Compact));
+        },
+        [sprintFieldId](const QByteArray& data, const PageCursor&) { return parseSearchPage(data, sprintFieldId); },
+        std::move(onPage),
+        [onDone](Outcome outcome) { onDone(outcome == Outcome::Ok, outcome == Outcome::AuthFailed); },
+        &JiraClient::peekNextPageToken);
+}
+
+void JiraClient::getIssueDetails(const QString& issueKey)
+{
+    if (issueKey.trimmed().isEmpty())
+    {
+        emit issueDetailsReady(JiraIssueDetails{issueKey, {}, {}, {}, {}});
+        return;
+    }
+
+    // Only the newest request per key may publish; a reload after a write must not be
+    // overwritten by an older reply that was already in flight.
+    const quint64 generation = ++m_issueGenerations[issueKey];
+
+    ensureFieldMetadata([this, issueKey, generation]() {
+        if (isStale(issueKey, generation))
             return;
-        }
 
-        QList<JiraHistoryEntry> history;
-        const auto root = doc.object();
-        const auto changelog = root.value("changelog").toObject();
-        const auto histories = changelog.value("histories").toArray();
-        for (const auto& hv : histories)
-        {
-            const auto entry = hv.toObject();
-            const auto createdStr = entry.value("created").toString();
-            auto when = QDateTime::fromString(createdStr, Qt::ISODateWithMs);
-            if (!when.isValid()) when = QDateTime::fromString(createdStr, Qt::ISODate);
+        QStringList fields;
+        fields << "description" << "assignee" << "duedate" << "comment";
+        if (!m_storyPointsFieldId.isEmpty()) fields << m_storyPointsFieldId;
+        if (!m_sprintFieldId.isEmpty()) fields << m_sprintFieldId;
 
-            QString author;
-            const auto authorObj = entry.value("author").toObject();
-            author = authorObj.value("displayName").toString();
+        QUrl url(m_basePlatform + "/issue/" + enc(issueKey));
+        QUrlQuery q;
+        q.addQueryItem("fields", fields.join(','));
+        q.addQueryItem("expand", "changelog,transitions");
+        url.setQuery(q);
 
-            const auto items = entry.value("items").toArray();
-            for (const auto& iv : items)
-            {
-                const auto item = iv.toObject();
-                JiraHistoryEntry h;
-                h.when = when;
-                h.author = author;
-                h.field = item.value("field").toString();
-                h.fromValue = item.value("fromString").toString();
-                h.toValue = item.value("toString").toString();
-                history.append(h);
-            }
-        }
+        const auto storyPointsFieldId = m_storyPointsFieldId;
+        const auto sprintFieldId = m_sprintFieldId;
+        request<DetailsResult>(
+            Call{.endpoint = "GetIssueDetails", .authAction = "loading issue details", .issueKey = issueKey, .generation = generation},
+            [this, url]() { return m_net.get(makeRequest(url)); },
+            [issueKey, storyPointsFieldId, sprintFieldId](const QByteArray& data) {
+                return parseIssueDetails(data, issueKey, storyPointsFieldId, sprintFieldId);
+            },
+            [this, issueKey](const Response<DetailsResult>& r) {
+                if (r.outcome == Outcome::Cancelled)
+                    return;
+                if (r.outcome != Outcome::Ok)
+                {
+                    emit issueDetailsReady(JiraIssueDetails{issueKey, {}, {}, {}, {}});
+                    return;
+                }
 
-        std::sort(history.begin(), history.end(), [](const JiraHistoryEntry& a, const JiraHistoryEntry& b) {
-            if (a.when != b.when) return a.when > b.when;
-            return a.author.toLower() > b.author.toLower();
-        });
+                auto details = r.value->details;
+                overlayFieldEdits(issueKey, details.fields);
+                emit issueDetailsReady(details);
+
+                // The embedded comment field is capped; page in the rest only when needed.
+                if (r.value->commentsTruncated)
+                    getIssueComments(issueKey);
+            });
+    });
+}
+
+void JiraClient::getIssueFieldSnapshot(const QString& issueKey)
+{
+    if (issueKey.trimmed().isEmpty())
+    {
+        emit issueFieldSnapshotReady(issueKey, JiraIssueFieldSnapshot{}, false);
+        return;
+    }
 
-        emit issueHistoryReady(history);
+    ensureFieldMetadata([this, issueKey]() {
+        // fields: description, assignee, duedate, story points (custom), sprint (custom)
+        QStringList fields;
+        fields << "description" << "assignee" << "duedate";
+        if (!m_storyPointsFieldId.isEmpty()) fields << m_storyPointsFieldId;
+        if (!m_sprintFieldId.isEmpty()) fields << m_sprintFieldId;
+
+        const QString fieldsParam = fields.join(',');
+        QUrl url(m_basePlatform + "/issue/" + enc(issueKey));
+        QUrlQuery q;
+        q.addQueryItem("fields", fieldsParam);
+        url.setQuery(q);
+
+        const auto storyPointsFieldId = m_storyPointsFieldId;
+        const auto sprintFieldId = m_sprintFieldId;
+        request<JiraIssueFieldSnapshot>(
+            Call{.endpoint = "GetIssueFields", .context = "GetIssueFieldSnapshot", .authAction = "loading issue details", .issueKey = issueKey},
+            [this, url]() { return m_net.get(makeRequest(url)); },
+            [storyPointsFieldId, sprintFieldId](const QByteArray& data) {
+                return parseFieldSnapshot(data, storyPointsFieldId, sprintFieldId);
+            },
+            [this, issueKey](const Response<JiraIssueFieldSnapshot>& r) {
+                if (r.outcome == Outcome::Cancelled)
+                    return;
+                if (r.outcome != Outcome::Ok)
+                {
+                    emit issueFieldSnapshotReady(issueKey, JiraIssueFieldSnapshot{}, false);
+                    return;
+                }
+                auto snapshot = *r.value;
+                overlayFieldEdits(issueKey, snapshot);
+                emit issueFieldSnapshotReady(issueKey, snapshot, true);
+            });
     });
 }
 
+void JiraClient::getIssueComments(const QString& issueKey)
+{
+    if (issueKey.trimmed().isEmpty())
+    {
+        emit issueCommentsReady(issueKey, {}, false);
+        return;
+    }
+
+    const int maxResults = 50;
+    const QString path = m_basePlatform + "/issue/" + enc(issueKey) + "/comment";
+    auto all = std::make_shared<QList<JiraComment>>();
+
+    paginate<JiraComment>(
+        Call{.endpoint = "GetIssueComments", .authAction = "loading comments", .issueKey = issueKey},
+        [this, path, maxResults](const PageCursor& at) {
+            QUrl url(path);
+            QUrlQuery q;
+            q.addQueryItem("startAt", QString::number(at.startAt));
+            q.addQueryItem("maxResults", QString::number(maxResults));
+            url.setQuery(q);
+            return m_net.get(makeRequest(url));
+        },
+        &JiraClient::parseCommentsPage,
+        [this, issueKey, all](const QList<JiraComment>& page) {
+            all->append(page);
+            emit issueCommentsLoading(issueKey, *all);
+        },
+        [this, issueKey, all](Outcome outcome) {
+            if (outcome == Outcome::Cancelled)
+                return;
+            if (outcome == Outcome::AuthFailed)
+                all->clear();
+            emit issueCommentsReady(issueKey, *all, outcome == Outcome::Ok);
+        });
+}
+
+void JiraClient::getIssueHistory(const QString& issueKey)
+{
+    if (issueKey.trimmed().isEmpty())
+    {
+        emit issueHistoryReady(issueKey, {}, false);
+        return;
+    }
+
+    QUrl url(m_basePlatform + "/issue/" + enc(issueKey));
+    QUrlQuery q;
+    q.addQueryItem("expand", "changelog");
+    q.addQueryItem("fields", "summary");
+    url.setQuery(q);
+
+    request<QList<JiraHistoryEntry>>(
+        Call{.endpoint = "GetIssueHistory", .authAction = "loading history", .issueKey = issueKey},
+        [this, url]() { return m_net.get(makeRequest(url)); },
+        &JiraClient::parseHistory,
+        [this, issueKey](const Response<QList<JiraHistoryEntry>>& r) {
+            if (r.outcome == Outcome::Cancelled)
+                return;
+            emit issueHistoryReady(issueKey, r.value.value_or(QList<JiraHistoryEntry>{}), r.outcome == Outcome::Ok);
+        });
+}
+
 void JiraClient::getTransitions(const QString& issueKey)
 {
     if (issueKey.trimmed().isEmpty())
@@ -523,75 +917,34 @@ void JiraClient::getTransitions(const QString& issueKey)
     }
 
     QUrl url(m_basePlatform + "/issue/" + enc(issueKey) + "/transitions");
-    QNetworkReply* reply = m_net.get(makeRequest(url));
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-        const auto data = reply->readAll();
-        const auto err = reply->error();
-        const auto errStr = reply->errorString();
-        reply->deleteLater();
-
-        if (err != QNetworkReply::NoError)
-        {
-            if (isAuthError(reply, err))
-            {
-                emit authenticationRequired("Jira authentication failed while loading transitions. Please configure your API token.");
-                emit transitionsReady({});
+    request<QList<JiraTransition>>(
+        Call{.endpoint = "GetTransitions", .authAction = "loading transitions", .issueKey = issueKey},
+        [this, url]() { return m_net.get(makeRequest(url)); },
+        &JiraClient::parseTransitions,
+        [this](const Response<QList<JiraTransition>>& r) {
+            if (r.outcome == Outcome::Cancelled)
                 return;
-            }
-            emit operationFailed("GetTransitions", errStr);
-            emit transitionsReady({});
-            return;
-        }
-
-        const auto doc = QJsonDocument::fromJson(data);
-        if (!doc.isObject())
-        {
-            emit operationFailed("GetTransitions", "Unexpected JSON (expected object)");
-            emit transitionsReady({});
-            return;
-        }
-
-        QList<JiraTransition> list;
-        const auto root = doc.object();
-        const auto arr = root.value("transitions").toArray();
-        for (const auto& v : arr)
-        {
-            const auto o = v.toObject();
-            const auto id = o.value("id").toString();
-            if (id.isEmpty()) continue;
-            list.append(JiraTransition{id, o.value("name").toString()});
-        }
-        emit transitionsReady(list);
-    });
+            emit transitionsReady(r.value.value_or(QList<JiraTransition>{}));
+        });
 }
 
 void JiraClient::updateIssueDescription(const QString& issueKey, const QString& plainText)
+{
+    updateIssueDescription(issueKey, Adf::fromPlainText(plainText));
+}
+
+void JiraClient::updateIssueDescription(const QString& issueKey, const QJsonObject& adf)
 {
     if (issueKey.trimmed().isEmpty()) return;
 
-    QUrl url(m_basePlatform + "/issue/" + enc(issueKey));
-    QJsonObject payload;
-    QJsonObject fields;
-    fields.insert("description", buildAdfDocument(plainText));
-    payload.insert("fields", fields);
+    JiraFieldEdit edit;
+    edit.fields = JiraFieldEdit::Description;
+    edit.values.descriptionAdf = adf;
+    edit.values.description = Adf::toPlainText(adf);
 
-    QNetworkReply* reply = m_net.put(makeRequest(url), QJsonDocument(payload).toJson(QJsonDocument::Compact));
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-        const auto err = reply->error();
-        const auto errStr = reply->errorString();
-        reply->deleteLater();
-        if (err != QNetworkReply::NoError)
-        {
-            if (isAuthError(reply, err))
-            {
-                emit authenticationRequired("Jira authentication failed while updating the description. Please configure your API token.");
-                return;
-            }
-            emit operationFailed("UpdateIssueDescription", errStr);
-            return;
-        }
-        emit operationSucceeded("Description updated");
-    });
+    QJsonObject fields;
+    fields.insert("description", adf);
+    stageFieldEdit(issueKey, edit, fields);
 }
 
 void JiraClient::addComment(const QString& issueKey, const QString& plainText)
@@ -600,25 +953,12 @@ void JiraClient::addComment(const QString& issueKey, const QString& plainText)
 
     QUrl url(m_basePlatform + "/issue/" + enc(issueKey) + "/comment");
     QJsonObject payload;
-    payload.insert("body", buildAdfDocument(plainText));
-
-    QNetworkReply* reply = m_net.post(makeRequest(url), QJsonDocument(payload).toJson(QJsonDocument::Compact));
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-        const auto err = reply->error();
-        const auto errStr = reply->errorString();
-        reply->deleteLater();
-        if (err != QNetworkReply::NoError)
-        {
-            if (isAuthError(reply, err))
-            {
-                emit authenticationRequired("Jira authentication failed while adding a comment. Please configure your API token.");
-                return;
-            }
-            emit operationFailed("AddComment", errStr);
-            return;
-        }
-        emit operationSucceeded("Comment posted");
-    });
+    payload.insert("body", Adf::fromPlainText(plainText));
+
+    const auto body = QJsonDocument(payload).toJson(QJsonDocument::Compact);
+    write(Call{.endpoint = "AddComment", .authAction = "adding a comment"},
+        issueKey, [this, url, body]() { return m_net.post(makeRequest(url), body); }, "Comment posted",
+        [this, issueKey]() { getIssueComments(issueKey); });
 }
 
 void JiraClient::updateComment(const QString& issueKey, const QString& commentId, const QString& plainText)
@@ -627,25 +967,12 @@ void JiraClient::updateComment(const QString& issueKey, const QString& commentId
 
     QUrl url(m_basePlatform + "/issue/" + enc(issueKey) + "/comment/" + enc(commentId));
     QJsonObject payload;
-    payload.insert("body", buildAdfDocument(plainText));
-
-    QNetworkReply* reply = m_net.put(makeRequest(url), QJsonDocument(payload).toJson(QJsonDocument::Compact));
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-        const auto err = reply->error();
-        const auto errStr = reply->errorString();
-        reply->deleteLater();
-        if (err != QNetworkReply::NoError)
-        {
-            if (isAuthError(reply, err))
-            {
-                emit authenticationRequired("Jira authentication failed while updating a comment. Please configure your API token.");
-                return;
-            }
-            emit operationFailed("UpdateComment", errStr);
-            return;
-        }
-        emit operationSucceeded("Comment updated");
-    });
+    payload.insert("body", Adf::fromPlainText(plainText));
+
+    const auto body = QJsonDocument(payload).toJson(QJsonDocument::Compact);
+    write(Call{.endpoint = "UpdateComment", .authAction = "updating a comment"},
+        issueKey, [this, url, body]() { return m_net.put(makeRequest(url), body); }, "Comment updated",
+        [this, issueKey]() { getIssueComments(issueKey); });
 }
 
 void JiraClient::updateStoryPoints(const QString& issueKey, const std::optional<double>& storyPoints)
@@ -655,32 +982,16 @@ void JiraClient::updateStoryPoints(const QString& issueKey, const std::optional<
     ensureFieldMetadata([this, issueKey, storyPoints]() {
         if (m_storyPointsFieldId.isEmpty()) return;
 
-        QUrl url(m_basePlatform + "/issue/" + enc(issueKey));
-        QJsonObject payload;
+        JiraFieldEdit edit;
+        edit.fields = JiraFieldEdit::StoryPoints;
+        edit.values.storyPoints = storyPoints;
+
         QJsonObject fields;
         if (storyPoints.has_value())
             fields.insert(m_storyPointsFieldId, *storyPoints);
         else
             fields.insert(m_storyPointsFieldId, QJsonValue(QJsonValue::Null));
-        payload.insert("fields", fields);
-
-        QNetworkReply* reply = m_net.put(makeRequest(url), QJsonDocument(payload).toJson(QJsonDocument::Compact));
-        QObject::connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-            const auto err = reply->error();
-            const auto errStr = reply->errorString();
-            reply->deleteLater();
-            if (err != QNetworkReply::NoError)
-            {
-                if (isAuthError(reply, err))
-                {
-                    emit authenticationRequired("Jira authentication failed while updating story points. Please configure your API token.");
-                    return;
-                }
-                emit operationFailed("UpdateStoryPoints", errStr);
-                return;
-            }
-            emit operationSucceeded("Story points updated");
-        });
+        stageFieldEdit(issueKey, edit, fields);
     });
 }
 
@@ -694,30 +1005,17 @@ void JiraClient::updateAssignee(const QString& issueKey, const QString& assignee
         if (!trimmed.isEmpty())
             accountId = resolved.isEmpty() ? trimmed : resolved;
 
-        QUrl url(m_basePlatform + "/issue/" + enc(issueKey) + "/assignee");
-        QJsonObject payload;
+        JiraFieldEdit edit;
+        edit.fields = JiraFieldEdit::Assignee;
+        edit.values.assigneeAccountId = accountId;
+        edit.values.assigneeDisplayName = trimmed;
+
+        QJsonObject fields;
         if (!accountId.isEmpty())
-            payload.insert("accountId", accountId);
+            fields.insert("assignee", QJsonObject{{"accountId", accountId}});
         else
-            payload.insert("accountId", QJsonValue(QJsonValue::Null));
-
-        QNetworkReply* reply = m_net.put(makeRequest(url), QJsonDocument(payload).toJson(QJsonDocument::Compact));
-        QObject::connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-            const auto err = reply->error();
-            const auto errStr = reply->errorString();
-            reply->deleteLater();
-        if (err != QNetworkReply::NoError)
-        {
-            if (isAuthError(reply, err))
-            {
-                emit authenticationRequired("Jira authentication failed while updating the assignee. Please configure your API token.");
-                return;
-            }
-            emit operationFailed("UpdateAssignee", errStr);
-            return;
-        }
-            emit operationSucceeded("Assignee updated");
-        });
+            fields.insert("assignee", QJsonValue(QJsonValue::Null));
+        stageFieldEdit(issueKey, edit, fields);
     });
 }
 
@@ -725,32 +1023,16 @@ void JiraClient::updateDueDate(const QString& issueKey, const std::optional<QDat
 {
     if (issueKey.trimmed().isEmpty()) return;
 
-    QUrl url(m_basePlatform + "/issue/" + enc(issueKey));
-    QJsonObject payload;
+    JiraFieldEdit edit;
+    edit.fields = JiraFieldEdit::DueDate;
+    edit.values.dueDate = dueDate;
+
     QJsonObject fields;
     if (dueDate.has_value())
         fields.insert("duedate", dueDate->toString("yyyy-MM-dd"));
     else
         fields.insert("duedate", QJsonValue(QJsonValue::Null));
-    payload.insert("fields", fields);
-
-    QNetworkReply* reply = m_net.put(makeRequest(url), QJsonDocument(payload).toJson(QJsonDocument::Compact));
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-        const auto err = reply->error();
-        const auto errStr = reply->errorString();
-        reply->deleteLater();
-        if (err != QNetworkReply::NoError)
-        {
-            if (isAuthError(reply, err))
-            {
-                emit authenticationRequired("Jira authentication failed while updating the due date. Please configure your API token.");
-                return;
-            }
-            emit operationFailed("UpdateDueDate", errStr);
-            return;
-        }
-        emit operationSucceeded("Due date updated");
-    });
+    stageFieldEdit(issueKey, edit, fields);
 }
 
 void JiraClient::updateSprint(const QString& issueKey, const std::optional<int>& sprintId)
@@ -760,10 +1042,18 @@ void JiraClient::updateSprint(const QString& issueKey, const std::optional<int>&
     ensureFieldMetadata([this, issueKey, sprintId]() {
         if (m_sprintFieldId.isEmpty()) return;
 
-        QUrl url(m_basePlatform + "/issue/" + enc(issueKey));
-        QJsonObject payload;
-        QJsonObject fields;
+        // The name comes from the agile cache when a board listed the sprint; otherwise
+        // the snapshot is refetched once the move is saved.
+        JiraFieldEdit edit;
+        edit.fields = JiraFieldEdit::Sprint;
+        edit.values.sprintId = sprintId;
+        if (sprintId.has_value())
+        {
+            if (const auto sprint = m_agileCache.sprint(*sprintId))
+                edit.values.sprintName = sprint->name;
+        }
 
+        QJsonObject fields;
         if (sprintId.has_value())
         {
             QJsonArray arr;
@@ -774,25 +1064,7 @@ void JiraClient::updateSprint(const QString& issueKey, const std::optional<int>&
         {
             fields.insert(m_sprintFieldId, QJsonValue(QJsonValue::Null));
         }
-        payload.insert("fields", fields);
-
-        QNetworkReply* reply = m_net.put(makeRequest(url), QJsonDocument(payload).toJson(QJsonDocument::Compact));
-        QObject::connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-            const auto err = reply->error();
-            const auto errStr = reply->errorString();
-            reply->deleteLater();
-        if (err != QNetworkReply::NoError)
-        {
-            if (isAuthError(reply, err))
-            {
-                emit authenticationRequired("Jira authentication failed while updating the sprint. Please configure your API token.");
-                return;
-            }
-            emit operationFailed("UpdateSprint", errStr);
-            return;
-        }
-            emit operationSucceeded("Sprint updated");
-        });
+        stageFieldEdit(issueKey, edit, fields);
     });
 }
 
@@ -806,89 +1078,338 @@ void JiraClient::transitionIssue(const QString& issueKey, const QString& transit
     transition.insert("id", transitionId);
     payload.insert("transition", transition);
 
-    QNetworkReply* reply = m_net.post(makeRequest(url), QJsonDocument(payload).toJson(QJsonDocument::Compact));
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-        const auto err = reply->error();
-        const auto errStr = reply->errorString();
-        reply->deleteLater();
-        if (err != QNetworkReply::NoError)
-        {
-            if (isAuthError(reply, err))
-            {
-                emit authenticationRequired("Jira authentication failed while transitioning the issue. Please configure your API token.");
-                return;
-            }
-            emit operationFailed("TransitionIssue", errStr);
-            return;
-        }
-        emit operationSucceeded("Transition applied");
-    });
+    const auto body = QJsonDocument(payload).toJson(QJsonDocument::Compact);
+    write(Call{.endpoint = "TransitionIssue", .authAction = "transitioning the issue"},
+        issueKey, [this, url, body]() { return m_net.post(makeRequest(url), body); }, "Transition applied",
+        [this, issueKey]() { getIssueDetails(issueKey); });
 }
 
 // ---- Tray helpers (Agile endpoints) ----
 
-void JiraClient::getMostRecentActiveSprint()
+static const QString kSprintBoardType = QStringLiteral("scrum");
+static const QString kSprintState = QStringLiteral("active");
+
+void JiraClient::bulkMoveToSprint(const QStringList& issueKeys, const std::optional<int>& sprintId)
 {
-    // Mirror C# logic: iterate scrum boards, check active sprints, pick most recent by startDate.
-    getAllBoards("scrum", [this](const QList<QJsonObject>& boards) {
-        if (boards.isEmpty())
-        {
-            emit mostRecentActiveSprintReady(std::nullopt, QString(), std::nullopt);
-            return;
-        }
+    flushFieldEdits();
+
+    // Both endpoints take up to 50 issues and are safe to repeat.
+    const QUrl url(sprintId.has_value() ? m_baseAgile + "/sprint/" + QString::number(*sprintId) + "/issue"
+                                        : m_baseAgile + "/backlog/issue");
+    QList<QStringList> batches;
+    for (qsizetype i = 0; i < issueKeys.size(); i += kAgileBulkLimit)
+        batches.append(issueKeys.mid(i, kAgileBulkLimit));
+
+    runBulk(sprintId.has_value() ? "Move to sprint" : "Move to backlog",
+        Call{.lane = Lane::Background, .endpoint = "BulkMoveToSprint"},
+        std::move(batches),
+        [this, url](const QStringList& keys) {
+            QJsonObject payload;
+            payload.insert("issues", QJsonArray::fromStringList(keys));
+            QNetworkRequest req = makeRequest(url);
+            RetryPolicy::markIdempotent(req);
+            return m_net.post(req, QJsonDocument(payload).toJson(QJsonDocument::Compact));
+        });
+}
 
-        struct Best { bool has{false}; int id{0}; QString name; QDateTime start; bool hasStart{false}; };
-        auto* best = new Best();
-        auto* remaining = new int(boards.size());
+void JiraClient::bulkTransition(const QStringList& issueKeys, const QString& transitionId)
+{
+    if (transitionId.trimmed().isEmpty()) return;
 
-        for (const auto& b : boards)
-        {
-            const int boardId = b.value("id").toInt();
-            getBoardSprints(boardId, "active", [this, best, remaining](const QList<QJsonObject>& sprints) {
-                for (const auto& s : sprints)
+    QJsonObject payload;
+    payload.insert("transition", QJsonObject{{"id", transitionId}});
+    const auto body = QJsonDocument(payload).toJson(QJsonDocument::Compact);
+
+    // Transition ids belong to a workflow; issues on another one fail individually.
+    QList<QStringList> batches;
+    for (const auto& key : issueKeys)
+        batches.append(QStringList{key});
+    runBulk("Transition",
+        Call{.lane = Lane::Background, .endpoint = "BulkTransition"},
+        std::move(batches),
+        [this, body](const QStringList& keys) {
+            const QUrl url(m_basePlatform + "/issue/" + enc(keys.first()) + "/transitions");
+            return m_net.post(makeRequest(url), body);
+        });
+}
+
+void JiraClient::bulkUpdateAssignee(const QStringList& issueKeys, const QString& assigneeInput)
+{
+    flushFieldEdits();
+
+    const QString trimmed = assigneeInput.trimmed();
+    resolveUserAccountId(trimmed, [this, issueKeys, trimmed](const QString& resolved) {
+        QJsonObject fields;
+        if (!trimmed.isEmpty())
+            fields.insert("assignee", QJsonObject{{"accountId", resolved.isEmpty() ? trimmed : resolved}});
+        else
+            fields.insert("assignee", QJsonValue(QJsonValue::Null));
+        bulkEditFields("Assign", "BulkUpdateAssignee", issueKeys, fields);
+    });
+}
+
+void JiraClient::bulkUpdateStoryPoints(const QStringList& issueKeys, const std::optional<double>& storyPoints)
+{
+    flushFieldEdits();
+
+    ensureFieldMetadata([this, issueKeys, storyPoints]() {
+        if (m_storyPointsFieldId.isEmpty()) return;
+
+        QJsonObject fields;
+        if (storyPoints.has_value())
+            fields.insert(m_storyPointsFieldId, *storyPoints);
+        else
+            fields.insert(m_storyPointsFieldId, QJsonValue(QJsonValue::Null));
+        bulkEditFields("Set story points", "BulkUpdateStoryPoints", issueKeys, fields);
+    });
+}
+
+void JiraClient::bulkUpdateDueDate(const QStringList& issueKeys, const std::optional<QDate>& dueDate)
+{
+    flushFieldEdits();
+
+    QJsonObject fields;
+    if (dueDate.has_value())
+        fields.insert("duedate", toIsoDate(dueDate));
+    else
+        fields.insert("duedate", QJsonValue(QJsonValue::Null));
+    bulkEditFields("Set due date", "BulkUpdateDueDate", issueKeys, fields);
+}
+
+void JiraClient::bulkEditFields(const QString& operation, const QString& endpoint, const QStringList& issueKeys,
+                                const QJsonObject& fields)
+{
+    QJsonObject payload;
+    payload.insert("fields", fields);
+    const auto body = QJsonDocument(payload).toJson(QJsonDocument::Compact);
+
+    QList<QStringList> batches;
+    for (const auto& key : issueKeys)
+        batches.append(QStringList{key});
+    runBulk(operation,
+        Call{.lane = Lane::Background, .endpoint = endpoint},
+        std::move(batches),
+        [this, body](const QStringList& keys) {
+            const QUrl url(m_basePlatform + "/issue/" + enc(keys.first()));
+            return m_net.put(makeRequest(url), body);
+        });
+}
+
+void JiraClient::runBulk(const QString& operation,
+                         const Call& call,
+                         QList<QStringList> batches,
+                         std::function<QNetworkReply*(const QStringList&)> send)
+{
+    // Owned by the requests in flight, like a Pager.
+    auto run = std::make_shared<BulkRun>();
+    run->call = call;
+    // Failures are collected into the result instead of one dialog per issue.
+    run->call.reportErrors = false;
+    run->send = std::move(send);
+    run->batches = std::move(batches);
+    for (const auto& b : run->batches)
+        run->total += int(b.size());
+    run->result.operation = operation;
+
+    emit bulkProgress(operation, 0, run->total);
+    issueBulkBatches(std::move(run));
+}
+
+void JiraClient::issueBulkBatches(std::shared_ptr<BulkRun> run)
+{
+    while (!run->authFailed && run->next < run->batches.size() && run->inFlight < kMaxBulkInFlight)
+    {
+        const QStringList keys = run->batches.at(run->next++);
+        ++run->inFlight;
+
+        request<std::monostate>(run->call,
+            [run, keys]() { return run->send(keys); },
+            {},
+            [this, run, keys](const Response<std::monostate>& r) {
+                --run->inFlight;
+                if (r.outcome == Outcome::Ok)
                 {
-                    const int id = s.value("id").toInt();
-                    const QString name = s.value("name").toString();
-                    const QString startStr = s.value("startDate").toString();
-                    QDateTime start = QDateTime::fromString(startStr, Qt::ISODateWithMs);
-                    if (!start.isValid()) start = QDateTime::fromString(startStr, Qt::ISODate);
-
-                    const bool hasStart = start.isValid();
-                    if (!best->has)
+                    for (const auto& key : keys)
+                        m_httpCache->invalidateIssue(key);
+                    run->result.succeeded += keys;
+                }
+                else
+                {
+                    QString error = r.error;
+                    if (r.outcome == Outcome::AuthFailed)
                     {
-                        best->has = true;
-                        best->id = id;
-                        best->name = name;
-                        best->start = start;
-                        best->hasStart = hasStart;
-                        continue;
+                        run->authFailed = true;
+                        error = QStringLiteral("Authentication failed");
                     }
-
-                    // Prefer larger (more recent) startDate.
-                    if (hasStart && (!best->hasStart || start > best->start))
+                    else if (error.isEmpty())
                     {
-                        best->id = id;
-                        best->name = name;
-                        best->start = start;
-                        best->hasStart = true;
+                        error = r.httpStatus ? QString("HTTP %1").arg(r.httpStatus) : QStringLiteral("Request failed");
                     }
+                    for (const auto& key : keys)
+                        run->result.failed.append(JiraBulkFailure{key, error});
                 }
+                run->done += int(keys.size());
+                emit bulkProgress(run->result.operation, run->done, run->total);
+                issueBulkBatches(run);
+            });
+    }
+
+    if (run->inFlight > 0 || (!run->authFailed && run->next < run->batches.size()))
+        return;
+
+    while (run->next < run->batches.size())
+        for (const auto& key : run->batches.at(run->next++))
+            run->result.failed.append(JiraBulkFailure{key, QStringLiteral("Not attempted")});
+
+    if (run->authFailed)
+        emit authenticationRequired("Jira authentication failed during a bulk update. Please configure your API token.");
+    emit bulkFinished(run->result);
+}
+
+void JiraClient::getMostRecentActiveSprint()
+{
+    // Mirror C# logic: iterate scrum boards, check active sprints, pick most recent by startDate.
+    // Answered from m_agileCache straight away (even if expired); only boards and board
+    // sprint lists past their TTL are re-fetched, in the background lane, at most
+    // maxInFlight at a time.
+    static const QString kTag = QStringLiteral("activeSprintScan");
+
+    std::optional<JiraSprint> cached;
+    bool fresh = false;
+    const bool haveCached = cachedMostRecentActiveSprint(cached, &fresh);
+    if (haveCached)
+    {
+        emitMostRecentActiveSprint(cached);
+        if (fresh)
+            return;
+    }
+
+    const quint64 generation = ++m_sprintScanGeneration;
+    m_scheduler.cancel(kTag);
+
+    const auto scanBoards = [this, generation, haveCached, cached](const QList<JiraBoard>& boards) {
+        QList<int> expired;
+        for (const auto& b : boards)
+            if (!m_agileCache.boardSprintsFresh(b.id, kSprintState))
+                expired.append(b.id);
+
+        struct Scan { qsizetype remaining{0}; bool done{false}; };
+        auto scan = std::make_shared<Scan>();
+        scan->remaining = expired.size();
+
+        const auto finish = [this, scan, haveCached, cached](bool authFailed) {
+            scan->done = true;
+            // Anything still queued for this scan can no longer change the answer.
+            m_scheduler.cancel(kTag);
+            m_agileCache.save(m_agileCacheIdentity);
+            if (authFailed)
+                emit authenticationRequired("Jira authentication failed while loading sprints. Please configure your API token.");
+
+            std::optional<JiraSprint> best;
+            cachedMostRecentActiveSprint(best);
+            const bool changed = best.has_value() != cached.has_value()
+                || (best && (best->id != cached->id || best->name != cached->name || best->startDate != cached->startDate));
+            if (!haveCached || changed)
+                emitMostRecentActiveSprint(best);
+        };
+
+        if (expired.isEmpty())
+        {
+            finish(false);
+            return;
+        }
+
+        for (const int boardId : expired)
+        {
+            getBoardSprints(boardId, kSprintState, kTag, [this, generation, scan, finish, boardId](const QList<JiraSprint>& sprints, bool complete, bool authFailed) {
+                if (scan->done || generation != m_sprintScanGeneration)
+                    return;
 
-                (*remaining)--;
-                if (*remaining == 0)
+                // Every other board would fail the same way; stop instead of issuing them.
+                if (authFailed)
                 {
-                    if (!best->has)
-                        emit mostRecentActiveSprintReady(std::nullopt, QString(), std::nullopt);
-                    else
-                        emit mostRecentActiveSprintReady(best->id, best->name, best->hasStart ? std::optional<QDateTime>(best->start) : std::nullopt);
-                    delete best;
-                    delete remaining;
+                    finish(true);
+                    return;
                 }
+
+                if (complete)
+                    m_agileCache.setBoardSprints(boardId, kSprintState, sprints);
+                if (--scan->remaining == 0)
+                    finish(false);
             });
         }
+    };
+
+    if (m_agileCache.boardsFresh(kSprintBoardType))
+    {
+        scanBoards(*m_agileCache.boards(kSprintBoardType));
+        return;
+    }
+
+    getAllBoards(kSprintBoardType, kTag, [this, generation, scanBoards, haveCached](const QList<JiraBoard>& boards, bool complete) {
+        if (generation != m_sprintScanGeneration)
+            return;
+        if (!complete)
+        {
+            // The cached answer (if any) was already emitted; keep it until the next attempt.
+            if (!haveCached)
+            {
+                std::optional<JiraSprint> best;
+                cachedMostRecentActiveSprint(best);
+                emitMostRecentActiveSprint(best);
+            }
+            return;
+        }
+
+        m_agileCache.setBoards(kSprintBoardType, boards);
+        scanBoards(boards);
     });
 }
 
+bool JiraClient::cachedMostRecentActiveSprint(std::optional<JiraSprint>& best, bool* fresh) const
+{
+    best.reset();
+    const auto boards = m_agileCache.boards(kSprintBoardType);
+    if (!boards)
+        return false;
+
+    bool complete = true;
+    bool allFresh = m_agileCache.boardsFresh(kSprintBoardType);
+    for (const auto& b : *boards)
+    {
+        const auto sprints = m_agileCache.boardSprints(b.id, kSprintState);
+        if (!sprints)
+        {
+            complete = false;
+            continue;
+        }
+        allFresh = allFresh && m_agileCache.boardSprintsFresh(b.id, kSprintState);
+
+        for (const auto& s : *sprints)
+        {
+            // Prefer larger (more recent) startDate; any sprint beats none.
+            if (!best || (s.startDate.isValid() && (!best->startDate.isValid() || s.startDate > best->startDate)))
+                best = s;
+        }
+    }
+
+    if (fresh)
+        *fresh = complete && allFresh;
+    return complete;
+}
+
+void JiraClient::emitMostRecentActiveSprint(const std::optional<JiraSprint>& sprint)
+{
+    if (!sprint)
+    {
+        emit mostRecentActiveSprintReady(std::nullopt, QString(), std::nullopt);
+        return;
+    }
+    emit mostRecentActiveSprintReady(sprint->id,
+                                     sprint->name,
+                                     sprint->startDate.isValid() ? std::optional<QDateTime>(sprint->startDate) : std::nullopt);
+}
+
 void JiraClient::getIssuesForSprint(int sprintId)
 {
     if (sprintId <= 0)
@@ -897,191 +1418,430 @@ void JiraClient::getIssuesForSprint(int sprintId)
         return;
     }
 
-    QList<JiraTicket> all;
     const int maxResults = 50;
+    const QString path = m_baseAgile + "/sprint/" + QString::number(sprintId) + "/issue";
+    auto all = std::make_shared<QList<JiraTicket>>();
+
+    paginate<JiraTicket>(
+        Call{.lane = Lane::Background, .endpoint = "GetSprintIssues", .context = "GetIssuesForSprint", .authAction = "loading sprint issues"},
+        [this, path, maxResults](const PageCursor& at) {
+            QUrl url(path);
+            QUrlQuery q;
+            q.addQueryItem("startAt", QString::number(at.startAt));
+            q.addQueryItem("maxResults", QString::number(maxResults));
+            url.setQuery(q);
+            return m_net.get(makeRequest(url));
+        },
+        &JiraClient::parseSprintIssuesPage,
+        [all](const QList<JiraTicket>& page) { all->append(page); },
+        [this, all](Outcome outcome) {
+            if (outcome == Outcome::AuthFailed)
+                all->clear();
+            emit sprintIssuesReady(*all);
+        });
+}
 
-    std::function<void(int)> fetch;
-    fetch = [this, sprintId, maxResults, &all, &fetch](int startAt) {
-        QUrl url(m_baseAgile + "/sprint/" + QString::number(sprintId) + "/issue");
-        QUrlQuery q;
-        q.addQueryItem("startAt", QString::number(startAt));
-        q.addQueryItem("maxResults", QString::number(maxResults));
-        url.setQuery(q);
+// ---- Response parsing (runs on m_parsePool; must not touch members) ----
 
-        QNetworkReply* reply = m_net.get(makeRequest(url));
-        QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, startAt, &all, fetch]() mutable {
-            const auto data = reply->readAll();
-            const auto err = reply->error();
-            const auto errStr = reply->errorString();
-            reply->deleteLater();
+std::optional<JiraClient::FieldIds> JiraClient::parseFieldMetadata(const QByteArray& data)
+{
+    const auto doc = QJsonDocument::fromJson(data);
+    if (!doc.isArray())
+        return std::nullopt;
 
-            if (err != QNetworkReply::NoError)
-            {
-                if (isAuthError(reply, err))
-                {
-                    emit authenticationRequired("Jira authentication failed while loading sprint issues. Please configure your API token.");
-                    emit sprintIssuesReady({});
-                    return;
-                }
-                emit operationFailed("GetIssuesForSprint", errStr);
-                emit sprintIssuesReady(all);
-                return;
-            }
+    FieldIds ids;
+    const auto arr = doc.array();
+    for (const auto& v : arr)
+    {
+        const auto o = v.toObject();
+        const auto name = o.value("name").toString();
+        const auto id = o.value("id").toString();
+        if (name.compare("Sprint", Qt::CaseInsensitive) == 0)
+            ids.sprint = id;
+        if (name.compare("Story Points", Qt::CaseInsensitive) == 0)
+            ids.storyPoints = id;
+    }
+    return ids;
+}
 
-            const auto doc = QJsonDocument::fromJson(data);
-            if (!doc.isObject())
-            {
-                emit operationFailed("GetIssuesForSprint", "Unexpected JSON (expected object)");
-                emit sprintIssuesReady(all);
-                return;
-            }
+std::optional<JiraClient::Page<JiraTicket>> JiraClient::parseSearchPage(const QByteArray& data, const QString& sprintFieldId)
+{
+    const auto doc = QJsonDocument::fromJson(data);
+    if (!doc.isObject())
+        return std::nullopt;
+
+    const auto root = doc.object();
+    const auto issues = root.value("issues").toArray();
+
+    Page<JiraTicket> page;
+    page.items.reserve(issues.size());
+    for (const auto& v : issues)
+        page.items.append(ticketFromIssue(v.toObject(), sprintFieldId));
+    const auto token = root.value("nextPageToken").toString();
+    if (!token.isEmpty())
+        page.next = PageCursor{0, token};
+    page.total = root.value("total").toInt(-1);
+    return page;
+}
 
-            const auto root = doc.object();
-            const auto issues = root.value("issues").toArray();
-            if (issues.isEmpty())
-            {
-                emit sprintIssuesReady(all);
-                return;
-            }
+std::optional<JiraClient::PageCursor> JiraClient::peekNextPageToken(const QByteArray& data)
+{
+    // The key as an object member: quoted, then a colon. Inside string values the quotes
+    // would be escaped, so issue text cannot fake it. Tokens are opaque base64-like
+    // strings; anything escaped is left to the real parse.
+    static const QByteArray key = QByteArrayLiteral("\"nextPageToken\"");
+    const qsizetype at = data.lastIndexOf(key);
+    if (at < 0)
+        return std::nullopt;
+
+    qsizetype i = at + key.size();
+    const auto skipSpace = [&data, &i]() {
+        while (i < data.size() && (data[i] == ' ' || data[i] == '\n' || data[i] == '\r' || data[i] == '\t'))
+            ++i;
+    };
+    skipSpace();
+    if (i >= data.size() || data[i] != ':')
+        return std::nullopt;
+    ++i;
+    skipSpace();
+    if (i >= data.size() || data[i] != '"')
+        return std::nullopt;
+
+    const qsizetype begin = ++i;
+    while (i < data.size() && data[i] != '"')
+    {
+        if (data[i] == '\\')
+            return std::nullopt;
+        ++i;
+    }
+    if (i >= data.size() || i == begin)
+        return std::nullopt;
+    return PageCursor{0, QString::fromUtf8(data.mid(begin, i - begin))};
+}
 
-            for (const auto& v : issues)
-            {
-                const auto issue = v.toObject();
-                const auto fields = issue.value("fields").toObject();
-
-                QString sprintName = "This Sprint";
-                const auto sprintVal = fields.value("sprint");
-                if (sprintVal.isObject())
-                    sprintName = sprintVal.toObject().value("name").toString(sprintName);
-
-                JiraTicket t;
-                t.key = issue.value("key").toString();
-                t.summary = fields.value("summary").toString();
-                t.status = fields.value("status").toObject().value("name").toString();
-                t.sprint = sprintName;
-                all.append(t);
-            }
+std::optional<JiraClient::Page<JiraTicket>> JiraClient::parseSprintIssuesPage(const QByteArray& data, const PageCursor& at)
+{
+    const auto doc = QJsonDocument::fromJson(data);
+    if (!doc.isObject())
+        return std::nullopt;
 
-            const int total = root.value("total").toInt(startAt + issues.size());
-            const int nextStart = startAt + root.value("maxResults").toInt(issues.size());
-            if (nextStart >= total)
-            {
-                emit sprintIssuesReady(all);
-                return;
-            }
-            fetch(nextStart);
-        });
-    };
+    const auto root = doc.object();
+    const auto issues = root.value("issues").toArray();
+
+    Page<JiraTicket> page;
+    page.items.reserve(issues.size());
+    for (const auto& v : issues)
+    {
+        const auto issue = v.toObject();
+        const auto fields = issue.value("fields").toObject();
+
+        QString sprintName = "This Sprint";
+        const auto sprintVal = fields.value("sprint");
+        if (sprintVal.isObject())
+            sprintName = sprintVal.toObject().value("name").toString(sprintName);
+
+        JiraTicket t;
+        t.key = issue.value("key").toString();
+        t.summary = fields.value("summary").toString();
+        t.status = fields.value("status").toObject().value("name").toString();
+        t.sprint = sprintName;
+        page.items.append(t);
+    }
 
-    fetch(0);
+    // The server may cap maxResults below what was asked; step by what it used.
+    const int pageSize = std::max(1, root.value("maxResults").toInt(int(issues.size())));
+    page.total = root.value("total").toInt(-1);
+    page.step = pageSize;
+    const int total = page.total >= 0 ? page.total : at.startAt + int(issues.size());
+    const int nextStart = at.startAt + pageSize;
+    if (!issues.isEmpty() && nextStart < total)
+        page.next = PageCursor{nextStart, QString()};
+    return page;
 }
 
-QJsonObject JiraClient::buildAdfDocument(const QString& plainText)
+std::optional<JiraIssueFieldSnapshot> JiraClient::parseFieldSnapshot(const QByteArray& data,
+                                                                     const QString& storyPointsFieldId,
+                                                                     const QString& sprintFieldId)
 {
-    const QString safe = plainText;
-    const auto parts = safe.split('\n');
+    const auto doc = QJsonDocument::fromJson(data);
+    if (!doc.isObject())
+        return std::nullopt;
 
-    QJsonArray content;
-    for (const auto& p : parts)
-    {
-        QJsonObject textNode;
-        textNode.insert("type", "text");
-        textNode.insert("text", p);
+    return snapshotFromFields(doc.object().value("fields").toObject(), storyPointsFieldId, sprintFieldId);
+}
 
-        QJsonArray paraContent;
-        paraContent.append(textNode);
+std::optional<JiraClient::Page<JiraComment>> JiraClient::parseCommentsPage(const QByteArray& data, const PageCursor& at)
+{
+    const auto doc = QJsonDocument::fromJson(data);
+    if (!doc.isObject())
+        return std::nullopt;
+
+    const auto root = doc.object();
+    const auto comments = root.value("comments").toArray();
+
+    Page<JiraComment> page;
+    page.items.reserve(comments.size());
+    for (const auto& v : comments)
+        page.items.append(commentFromJson(v.toObject()));
+    page.total = root.value("total").toInt(-1);
+    page.step = root.value("maxResults").toInt(int(comments.size()));
+
+    const int nextStart = at.startAt + int(comments.size());
+    const int total = page.total >= 0 ? page.total : nextStart;
+    if (!comments.isEmpty() && nextStart < total)
+        page.next = PageCursor{nextStart, QString()};
+    return page;
+}
 
-        QJsonObject paragraph;
-        paragraph.insert("type", "paragraph");
-        paragraph.insert("content", paraContent);
+template <typename Item>
+std::optional<JiraClient::Page<Item>> JiraClient::parseValuesPage(const QByteArray& data, const PageCursor& at,
+                                                                 Item (*fromJson)(const QJsonObject&))
+{
+    const auto doc = QJsonDocument::fromJson(data);
+    if (!doc.isObject())
+        return std::nullopt;
+
+    const auto root = doc.object();
+    const auto values = root.value("values").toArray();
+
+    Page<Item> page;
+    page.items.reserve(values.size());
+    for (const auto& v : values)
+        page.items.append(fromJson(v.toObject()));
+    page.total = root.value("total").toInt(-1); // boards report it, sprint lists do not
+    page.step = root.value("maxResults").toInt(int(values.size()));
+    if (!root.value("isLast").toBool(false) && !values.isEmpty())
+        page.next = PageCursor{at.startAt + int(values.size()), QString()};
+    return page;
+}
 
-        content.append(paragraph);
-    }
+std::optional<QList<JiraHistoryEntry>> JiraClient::parseHistory(const QByteArray& data)
+{
+    const auto doc = QJsonDocument::fromJson(data);
+    if (!doc.isObject())
+        return std::nullopt;
 
-    QJsonObject doc;
-    doc.insert("version", 1);
-    doc.insert("type", "doc");
-    doc.insert("content", content);
-    return doc;
+    return historyFromChangelog(doc.object().value("changelog").toObject());
 }
 
-QString JiraClient::adfToPlainText(const QJsonValue& adf)
+std::optional<QList<JiraTransition>> JiraClient::parseTransitions(const QByteArray& data)
 {
-    // Port of C# AdfChildToPlainText: walks doc/paragraph/text/hardBreak.
-    QStringList out;
+    const auto doc = QJsonDocument::fromJson(data);
+    if (!doc.isObject())
+        return std::nullopt;
 
-    std::function<void(const QJsonValue&, QStringList&)> walk;
-    walk = [&walk](const QJsonValue& node, QStringList& lines) {
-        if (node.isNull() || node.isUndefined()) return;
+    return transitionsFromJson(doc.object().value("transitions").toArray());
+}
 
-        if (node.isArray())
-        {
-            bool first = true;
-            for (const auto& v : node.toArray())
-            {
-                if (!first) lines.append("");
-                first = false;
-                walk(v, lines);
-            }
-            return;
-        }
+std::optional<JiraClient::DetailsResult> JiraClient::parseIssueDetails(const QByteArray& data,
+                                                                       const QString& issueKey,
+                                                                       const QString& storyPointsFieldId,
+                                                                       const QString& sprintFieldId)
+{
+    const auto doc = QJsonDocument::fromJson(data);
+    if (!doc.isObject())
+        return std::nullopt;
+
+    const auto root = doc.object();
+    const auto fields = root.value("fields").toObject();
+
+    DetailsResult result;
+    auto& d = result.details;
+    d.key = issueKey;
+    d.valid = true;
+    d.fields = snapshotFromFields(fields, storyPointsFieldId, sprintFieldId);
+    d.history = historyFromChangelog(root.value("changelog").toObject());
+    d.transitions = transitionsFromJson(root.value("transitions").toArray());
+
+    const auto commentObj = fields.value("comment").toObject();
+    const auto comments = commentObj.value("comments").toArray();
+    d.comments.reserve(comments.size());
+    for (const auto& v : comments)
+        d.comments.append(commentFromJson(v.toObject()));
+    result.commentsTruncated = commentObj.value("total").toInt(comments.size()) > comments.size();
+
+    return result;
+}
 
-        if (!node.isObject()) return;
+JiraBoard JiraClient::boardFromJson(const QJsonObject& b)
+{
+    JiraBoard board;
+    board.id = b.value("id").toInt();
+    board.name = b.value("name").toString();
+    board.type = b.value("type").toString();
+    return board;
+}
+
+JiraSprint JiraClient::sprintFromJson(const QJsonObject& s)
+{
+    JiraSprint sprint;
+    sprint.id = s.value("id").toInt();
+    sprint.name = s.value("name").toString();
+    sprint.state = s.value("state").toString();
+    sprint.startDate = parseJiraDateTime(s.value("startDate").toString());
+    sprint.endDate = parseJiraDateTime(s.value("endDate").toString());
+    return sprint;
+}
+
+QList<JiraTransition> JiraClient::transitionsFromJson(const QJsonArray& transitions)
+{
+    QList<JiraTransition> list;
+    for (const auto& v : transitions)
+    {
+        const auto o = v.toObject();
+        const auto id = o.value("id").toString();
+        if (id.isEmpty()) continue;
+        list.append(JiraTransition{id, o.value("name").toString()});
+    }
+    return list;
+}
+
+JiraTicket JiraClient::ticketFromIssue(const QJsonObject& issue, const QString& sprintFieldId)
+{
+    const auto fields = issue.value("fields").toObject();
 
-        const auto o = node.toObject();
-        const auto type = o.value("type").toString();
+    JiraTicket t;
+    t.key = issue.value("key").toString();
+    t.summary = fields.value("summary").toString();
+    t.status = fields.value("status").toObject().value("name").toString();
+    t.updated = parseJiraDateTime(fields.value("updated").toString());
 
-        if (type == "doc")
+    t.sprint = QStringLiteral("No Sprint");
+    if (!sprintFieldId.isEmpty() && fields.contains(sprintFieldId))
+    {
+        const auto sprintVal = fields.value(sprintFieldId);
+        if (sprintVal.isArray() && !sprintVal.toArray().isEmpty())
         {
-            const auto content = o.value("content").toArray();
-            bool firstPara = true;
-            for (const auto& v : content)
-            {
-                if (!firstPara) lines.append("");
-                firstPara = false;
-                walk(v, lines);
-            }
-            return;
+            const auto first = sprintVal.toArray().first();
+            if (first.isObject())
+                t.sprint = first.toObject().value("name").toString("Sprint");
+            else if (first.isString())
+                t.sprint = first.toString();
         }
-
-        if (type == "paragraph")
+        else if (sprintVal.isObject())
         {
-            const auto content = o.value("content").toArray();
-            if (lines.isEmpty()) lines.append(QString());
-            for (const auto& v : content)
-            {
-                walk(v, lines);
-            }
-            return;
+            t.sprint = sprintVal.toObject().value("name").toString("Sprint");
         }
-
-        if (type == "hardBreak")
+        else if (sprintVal.isString())
         {
-            lines.append(QString());
-            return;
+            t.sprint = sprintVal.toString();
         }
+    }
+    return t;
+}
+
+JiraIssueFieldSnapshot JiraClient::snapshotFromFields(const QJsonObject& fieldsObj,
+                                                      const QString& storyPointsFieldId,
+                                                      const QString& sprintFieldId)
+{
+    JiraIssueFieldSnapshot snap;
+
+    // Description (ADF)
+    const auto desc = fieldsObj.value("description");
+    if (!desc.isNull() && !desc.isUndefined())
+        snap.description = Adf::toPlainText(desc);
+    if (desc.isObject())
+        snap.descriptionAdf = desc.toObject();
+
+    // Story points
+    if (!storyPointsFieldId.isEmpty())
+    {
+        const auto sp = fieldsObj.value(storyPointsFieldId);
+        if (sp.isDouble()) snap.storyPoints = sp.toDouble();
+    }
+
+    // Assignee
+    const auto assignee = fieldsObj.value("assignee");
+    if (assignee.isObject())
+    {
+        const auto ao = assignee.toObject();
+        snap.assigneeDisplayName = ao.value("displayName").toString();
+        snap.assigneeAccountId = ao.value("accountId").toString();
+    }
 
-        if (type == "text")
+    // Due date
+    const auto due = fieldsObj.value("duedate").toString();
+    if (!due.isEmpty())
+    {
+        const auto d = QDate::fromString(due, Qt::ISODate);
+        if (d.isValid()) snap.dueDate = d;
+    }
+
+    // Sprint
+    if (!sprintFieldId.isEmpty())
+    {
+        const auto sprintVal = fieldsObj.value(sprintFieldId);
+        if (sprintVal.isArray() && !sprintVal.toArray().isEmpty())
         {
-            if (lines.isEmpty()) lines.append(QString());
-            auto current = lines.takeLast();
-            current += o.value("text").toString();
-            lines.append(current);
-            return;
+            const auto first = sprintVal.toArray().first();
+            extractSprint(first, snap.sprintId, snap.sprintName);
+            if (snap.sprintName.isEmpty() && first.isString())
+                snap.sprintName = parseSprintNameFromLegacyString(first.toString());
+        }
+        else if (sprintVal.isObject())
+        {
+            extractSprint(sprintVal, snap.sprintId, snap.sprintName);
+        }
+        else if (sprintVal.isString())
+        {
+            snap.sprintName = parseSprintNameFromLegacyString(sprintVal.toString());
         }
+    }
+
+    return snap;
+}
 
-        // Fallback: walk children if present
-        const auto content = o.value("content");
-        if (content.isArray())
+JiraComment JiraClient::commentFromJson(const QJsonObject& c)
+{
+    JiraComment jc;
+    jc.id = c.value("id").toString();
+    const auto authorObj = c.value("author").toObject();
+    jc.author = authorObj.value("displayName").toString();
+    const auto createdStr = c.value("created").toString();
+    jc.created = QDateTime::fromString(createdStr, Qt::ISODateWithMs);
+    if (!jc.created.isValid())
+        jc.created = QDateTime::fromString(createdStr, Qt::ISODate);
+
+    const auto body = c.value("body");
+    if (body.isString()) jc.editableBody = body.toString();
+    else jc.editableBody = Adf::toPlainText(body);
+    return jc;
+}
+
+QList<JiraHistoryEntry> JiraClient::historyFromChangelog(const QJsonObject& changelog)
+{
+    QList<JiraHistoryEntry> history;
+    const auto histories = changelog.value("histories").toArray();
+    for (const auto& hv : histories)
+    {
+        const auto entry = hv.toObject();
+        const auto createdStr = entry.value("created").toString();
+        auto when = QDateTime::fromString(createdStr, Qt::ISODateWithMs);
+        if (!when.isValid()) when = QDateTime::fromString(createdStr, Qt::ISODate);
+
+        QString author;
+        const auto authorObj = entry.value("author").toObject();
+        author = authorObj.value("displayName").toString();
+
+        const auto items = entry.value("items").toArray();
+        for (const auto& iv : items)
         {
-            for (const auto& v : content.toArray())
-                walk(v, lines);
+            const auto item = iv.toObject();
+            JiraHistoryEntry h;
+            h.when = when;
+            h.author = author;
+            h.field = item.value("field").toString();
+            h.fromValue = item.value("fromString").toString();
+            h.toValue = item.value("toString").toString();
+            history.append(h);
         }
-    };
+    }
 
-    walk(adf, out);
-    while (!out.isEmpty() && out.last().trimmed().isEmpty()) out.removeLast();
-    return out.join("\n").trimmed();
+    std::sort(history.begin(), history.end(), [](const JiraHistoryEntry& a, const JiraHistoryEntry& b) {
+        if (a.when != b.when) return a.when > b.when;
+        return a.author.toString().toLower() > b.author.toString().toLower();
+    });
+    return history;
 }
 
 // ---- Helper implementations ----
@@ -1097,10 +1857,10 @@ QString JiraClient::parseSprintNameFromLegacyString(const QString& raw)
     return (end > 0 ? after.left(end) : after).trimmed();
 }
 
-void JiraClient::extractSprint(const QJsonValue& element, std::optional<int>& id, QString& name)
+void JiraClient::extractSprint(const QJsonValue& element, std::optional<int>& id, InternedString& name)
 {
     id.reset();
-    name.clear();
+    name = {};
     if (!element.isObject()) return;
     const auto o = element.toObject();
     if (o.value("id").isDouble()) id = o.value("id").toInt();
@@ -1119,162 +1879,78 @@ void JiraClient::resolveUserAccountId(const QString& query, std::function<void(c
     QJsonObject payload;
     payload.insert("query", query);
     payload.insert("maxResults", 1);
-    QNetworkReply* reply = m_net.post(makeRequest(url), QJsonDocument(payload).toJson(QJsonDocument::Compact));
-    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, cont]() {
-        const auto data = reply->readAll();
-        const auto err = reply->error();
-        const auto errStr = reply->errorString();
-        reply->deleteLater();
-
-        if (err != QNetworkReply::NoError)
-        {
-            if (isAuthError(reply, err))
-            {
-                emit authenticationRequired("Jira authentication failed while resolving an account id. Please configure your API token.");
-                cont(QString());
-                return;
-            }
-            emit operationFailed("ResolveUserAccountId", errStr);
-            cont(QString());
-            return;
-        }
-
-        const auto doc = QJsonDocument::fromJson(data);
-        if (!doc.isArray() || doc.array().isEmpty())
-        {
-            cont(QString());
-            return;
-        }
-
-        const auto first = doc.array().first().toObject();
-        cont(first.value("accountId").toString());
-    });
+    const auto body = QJsonDocument(payload).toJson(QJsonDocument::Compact);
+    request<QString>(
+        Call{.endpoint = "SearchUsers", .context = "ResolveUserAccountId", .authAction = "resolving an account id"},
+        [this, url, body]() {
+            QNetworkRequest req = makeRequest(url);
+            RetryPolicy::markIdempotent(req);
+            return m_net.post(req, body);
+        },
+        [](const QByteArray& data) -> std::optional<QString> {
+            // No match is not an error: the caller falls back to the raw input.
+            const auto doc = QJsonDocument::fromJson(data);
+            if (!doc.isArray() || doc.array().isEmpty())
+                return QString();
+            return doc.array().first().toObject().value("accountId").toString();
+        },
+        [cont](const Response<QString>& r) { cont(r.value.value_or(QString())); });
 }
 
-void JiraClient::getAllBoards(const QString& type, std::function<void(const QList<QJsonObject>&)> cont)
+void JiraClient::getAllBoards(const QString& type, const QString& tag, std::function<void(const QList<JiraBoard>&, bool)> cont)
 {
     // GET /board?startAt=..&maxResults=..&type=scrum
-    auto* all = new QList<QJsonObject>();
     const int max = 50;
-
-    std::function<void(int)> fetch;
-    fetch = [this, type, max, all, cont, &fetch](int startAt) {
-        QUrl url(m_baseAgile + "/board");
-        QUrlQuery q;
-        q.addQueryItem("startAt", QString::number(startAt));
-        q.addQueryItem("maxResults", QString::number(max));
-        if (!type.isEmpty()) q.addQueryItem("type", type);
-        url.setQuery(q);
-
-        QNetworkReply* reply = m_net.get(makeRequest(url));
-        QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, startAt, max, all, cont, fetch]() mutable {
-            const auto data = reply->readAll();
-            const auto err = reply->error();
-            const auto errStr = reply->errorString();
-            reply->deleteLater();
-
-            if (err != QNetworkReply::NoError)
-            {
-                if (isAuthError(reply, err))
-                {
-                    emit authenticationRequired("Jira authentication failed while loading boards. Please configure your API token.");
-                    cont({});
-                    delete all;
-                    return;
-                }
-                emit operationFailed("GetAllBoards", errStr);
-                cont(*all);
-                delete all;
-                return;
-            }
-
-            const auto doc = QJsonDocument::fromJson(data);
-            if (!doc.isObject())
-            {
-                emit operationFailed("GetAllBoards", "Unexpected JSON (expected object)");
-                cont(*all);
-                delete all;
+    auto all = std::make_shared<QList<JiraBoard>>();
+
+    paginate<JiraBoard>(
+        Call{.lane = Lane::Background, .endpoint = "GetBoards", .context = "GetAllBoards", .authAction = "loading boards", .tag = tag},
+        [this, type, max](const PageCursor& at) {
+            QUrl url(m_baseAgile + "/board");
+            QUrlQuery q;
+            q.addQueryItem("startAt", QString::number(at.startAt));
+            q.addQueryItem("maxResults", QString::number(max));
+            if (!type.isEmpty()) q.addQueryItem("type", type);
+            url.setQuery(q);
+            return m_net.get(makeRequest(url));
+        },
+        [](const QByteArray& data, const PageCursor& at) { return parseValuesPage<JiraBoard>(data, at, &JiraClient::boardFromJson); },
+        [all](const QList<JiraBoard>& page) { all->append(page); },
+        [all, cont](Outcome outcome) {
+            // Cancelled scans are superseded; nobody is waiting for the result.
+            if (outcome == Outcome::Cancelled)
                 return;
-            }
-
-            const auto root = doc.object();
-            const auto values = root.value("values").toArray();
-            for (const auto& v : values) all->append(v.toObject());
-            const bool isLast = root.value("isLast").toBool(false);
-            if (isLast || values.isEmpty())
-            {
-                cont(*all);
-                delete all;
-                return;
-            }
-
-            fetch(startAt + values.size());
+            if (outcome == Outcome::AuthFailed)
+                all->clear();
+            cont(*all, outcome == Outcome::Ok);
         });
-    };
-
-    fetch(0);
 }
 
-void JiraClient::getBoardSprints(int boardId, const QString& state, std::function<void(const QList<QJsonObject>&)> cont)
+void JiraClient::getBoardSprints(int boardId,
+                                 const QString& state,
+                                 const QString& tag,
+                                 std::function<void(const QList<JiraSprint>&, bool, bool)> cont)
 {
-    auto* all = new QList<QJsonObject>();
     const int max = 50;
-
-    std::function<void(int)> fetch;
-    fetch = [this, boardId, state, max, all, cont, &fetch](int startAt) {
-        QUrl url(m_baseAgile + "/board/" + QString::number(boardId) + "/sprint");
-        QUrlQuery q;
-        q.addQueryItem("startAt", QString::number(startAt));
-        q.addQueryItem("maxResults", QString::number(max));
-        if (!state.isEmpty()) q.addQueryItem("state", state);
-        url.setQuery(q);
-
-        QNetworkReply* reply = m_net.get(makeRequest(url));
-        QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, startAt, all, cont, fetch]() mutable {
-            const auto data = reply->readAll();
-            const auto err = reply->error();
-            const auto errStr = reply->errorString();
-            reply->deleteLater();
-
-            if (err != QNetworkReply::NoError)
-            {
-                if (isAuthError(reply, err))
-                {
-                    emit authenticationRequired("Jira authentication failed while loading sprints. Please configure your API token.");
-                    cont({});
-                    delete all;
-                    return;
-                }
-                emit operationFailed("GetBoardSprints", errStr);
-                cont(*all);
-                delete all;
-                return;
-            }
-
-            const auto doc = QJsonDocument::fromJson(data);
-            if (!doc.isObject())
-            {
-                emit operationFailed("GetBoardSprints", "Unexpected JSON (expected object)");
-                cont(*all);
-                delete all;
-                return;
-            }
-
-            const auto root = doc.object();
-            const auto values = root.value("values").toArray();
-            for (const auto& v : values) all->append(v.toObject());
-
-            const bool isLast = root.value("isLast").toBool(false);
-            if (isLast || values.isEmpty())
-            {
-                cont(*all);
-                delete all;
-                return;
-            }
-
-            fetch(startAt + values.size());
+    auto all = std::make_shared<QList<JiraSprint>>();
+
+    // No authAction: the sprint scan reports an auth failure once, not per board.
+    paginate<JiraSprint>(
+        Call{.lane = Lane::Background, .endpoint = "GetBoardSprints", .tag = tag},
+        [this, boardId, state, max](const PageCursor& at) {
+            QUrl url(m_baseAgile + "/board/" + QString::number(boardId) + "/sprint");
+            QUrlQuery q;
+            q.addQueryItem("startAt", QString::number(at.startAt));
+            q.addQueryItem("maxResults", QString::number(max));
+            if (!state.isEmpty()) q.addQueryItem("state", state);
+            url.setQuery(q);
+            return m_net.get(makeRequest(url));
+        },
+        [](const QByteArray& data, const PageCursor& at) { return parseValuesPage<JiraSprint>(data, at, &JiraClient::sprintFromJson); },
+        [all](const QList<JiraSprint>& page) { all->append(page); },
+        [all, cont](Outcome outcome) {
+            if (outcome == Outcome::AuthFailed)
+                all->clear();
+            cont(*all, outcome == Outcome::Ok, outcome == Outcome::AuthFailed);
         });
-    };
-
-    fetch(0);
 }
@@ -1,16 +1,30 @@
 #pragma once
 
 #include <QObject>
+#include <QHash>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QPointer>
+#include <QThreadPool>
+#include <QTimer>
 #include <QList>
+#include <QJsonArray>
 #include <QJsonObject>
 #include <QJsonValue>
+#include <QtConcurrent/QtConcurrentRun>
 
 #include <functional>
+#include <memory>
+#include <optional>
+#include <variant>
 
+#include "agilecache.h"
+#include "fieldcache.h"
+#include "httpcache.h"
 #include "models.h"
+#include "requestscheduler.h"
+#include "requesttracer.h"
+#include "retrypolicy.h"
 
 class JiraClient : public QObject
 {
@@ -20,20 +34,50 @@ public:
 
     void configure(const QString& instanceUrl, const QString& username, const QString& apiToken);
 
+    // Upper bound on concurrent requests; the rest wait in m_scheduler's queues.
+    void setMaxConcurrentRequests(int maxInFlight) { m_scheduler.setMaxInFlight(maxInFlight); }
+
+    // GET responses are kept in an on-disk cache and revalidated with If-None-Match /
+    // If-Modified-Since on reuse. Writes drop the affected issue's entries themselves.
+    void setHttpCacheSize(qint64 maxBytes);
+
+    // Per-endpoint latency/size statistics for every request this client sends.
+    RequestTracer& tracer() { return m_tracer; }
+    void invalidateIssueCache(const QString& issueKey);
+
+    // The issue the UI is showing. Switching aborts in-flight detail requests for other
+    // keys and suppresses any of their results that still arrive; empty disables this.
+    void setActiveIssue(const QString& issueKey);
+
     void getMyTickets();
+    // Delta sync: only "my tickets" updated at or after `since` (minute precision).
+    void getMyTicketsUpdatedSince(const QDateTime& since);
+    // Keys-only variant of getMyTickets, used to reconcile removals after delta syncs.
+    void getMyTicketKeys();
+
+    // Snapshot fields, comments, changelog and transitions in one round trip
+    // (expand=changelog,transitions plus the comment field); emits issueDetailsReady.
+    void getIssueDetails(const QString& issueKey);
     void getIssueFieldSnapshot(const QString& issueKey);
     void getIssueComments(const QString& issueKey);
     void getIssueHistory(const QString& issueKey);
     void getTransitions(const QString& issueKey);
 
-    // Tray helpers (mirrors TrayViewModel in the WPF app)
+    // Tray helpers (mirrors TrayViewModel in the WPF app). These run in the background
+    // lane; a new sprint scan cancels whatever is left of the previous one. The sprint
+    // lookup answers from the board/sprint cache first and re-emits if revalidation
+    // changes the result.
     void getMostRecentActiveSprint();
     void getIssuesForSprint(int sprintId);
 
     void updateIssueDescription(const QString& issueKey, const QString& plainText);
+    void updateIssueDescription(const QString& issueKey, const QJsonObject& adf);
     void addComment(const QString& issueKey, const QString& plainText);
     void updateComment(const QString& issueKey, const QString& commentId, const QString& plainText);
 
+    // Description and field edits are applied locally straight away (issueFieldsEdited),
+    // buffered briefly per issue and sent as one `fields` PUT; edits made while that PUT is
+    // in flight go out together after it.
     void updateStoryPoints(const QString& issueKey, const std::optional<double>& storyPoints);
     void updateAssignee(const QString& issueKey, const QString& assigneeInput);
     void updateDueDate(const QString& issueKey, const std::optional<QDate>& dueDate);
@@ -41,30 +85,253 @@ public:
 
     void transitionIssue(const QString& issueKey, const QString& transitionId);
 
+    // Sends buffered field edits without waiting for the coalescing window.
+    void flushFieldEdits();
+
+    // Bulk writes over many issues, each run as one operation: bulkProgress counts issues
+    // as they complete and bulkFinished reports the result, including per-issue failures.
+    // Sprint moves use the agile bulk endpoints (kAgileBulkLimit issues per request); the
+    // others send one request per issue in the background lane, at most kMaxBulkInFlight
+    // at a time.
+    void bulkMoveToSprint(const QStringList& issueKeys, const std::optional<int>& sprintId);
+    void bulkTransition(const QStringList& issueKeys, const QString& transitionId);
+    void bulkUpdateAssignee(const QStringList& issueKeys, const QString& assigneeInput);
+    void bulkUpdateStoryPoints(const QStringList& issueKeys, const std::optional<double>& storyPoints);
+    void bulkUpdateDueDate(const QStringList& issueKeys, const std::optional<QDate>& dueDate);
+    bool hasPendingFieldEdits(const QString& issueKey) const
+    {
+        return m_stagedEdits.contains(issueKey) || m_sendingEdits.contains(issueKey);
+    }
+
 signals:
-    void myTicketsReady(const QList<JiraTicket>& tickets);
-    void issueFieldSnapshotReady(const JiraIssueFieldSnapshot& snapshot);
-    void issueCommentsReady(const QList<JiraComment>& comments);
-    void issueHistoryReady(const QList<JiraHistoryEntry>& entries);
+    // getMyTickets streams each search page as it lands, in server order, then sends the
+    // whole result through myTicketsReady.
+    void myTicketsPage(const QList<JiraTicket>& page);
+    // `complete` is false when a page failed and the result only covers the pages before it.
+    void myTicketsReady(const QList<JiraTicket>& tickets, bool complete);
+    void myTicketsDeltaReady(const QList<JiraTicket>& tickets, bool complete);
+    void myTicketKeysReady(const QStringList& keys, bool complete);
+    // `complete` is false when the fetch failed; the payload is then empty or, for
+    // comments, only the pages that arrived before the failure.
+    void issueFieldSnapshotReady(const QString& issueKey, const JiraIssueFieldSnapshot& snapshot, bool complete);
+    void issueCommentsReady(const QString& issueKey, const QList<JiraComment>& comments, bool complete);
+    // Comments received so far while later pages are still loading; issueCommentsReady follows.
+    void issueCommentsLoading(const QString& issueKey, const QList<JiraComment>& received);
+    void issueHistoryReady(const QString& issueKey, const QList<JiraHistoryEntry>& entries, bool complete);
     void transitionsReady(const QList<JiraTransition>& transitions);
+    void issueDetailsReady(const JiraIssueDetails& details);
 
     void mostRecentActiveSprintReady(const std::optional<int>& sprintId,
                                     const QString& sprintName,
                                     const std::optional<QDateTime>& startDate);
     void sprintIssuesReady(const QList<JiraTicket>& tickets);
 
+    // Optimistic field edits: applied locally when made, then confirmed by Jira or undone.
+    // A reverted edit names the fields to restore to their last confirmed values; fields
+    // edited again since are left out.
+    void issueFieldsEdited(const QString& issueKey, const JiraFieldEdit& edit);
+    void issueFieldsSaved(const QString& issueKey, const JiraFieldEdit& edit);
+    void issueFieldsReverted(const QString& issueKey, const JiraFieldEdit& edit);
+
+    void bulkProgress(const QString& operation, int done, int total);
+    void bulkFinished(const JiraBulkResult& result);
+
     void operationSucceeded(const QString& message);
     void operationFailed(const QString& context, const QString& error);
     void authenticationRequired(const QString& message);
 
 private:
+    using Lane = RequestScheduler::Lane;
+
+    // Queues a request on m_scheduler. `send` issues it once a slot is free and may return
+    // nullptr to skip it (e.g. the issue is no longer selected), in which case `onFinished`
+    // never runs. `onDropped` runs instead if the job is cancelled by tag before it starts.
+    // `endpoint` holds the call's m_tracer statistics.
+    // Failures m_retryPolicy deems transient are sent again after a delay; `onFinished`
+    // only sees the last attempt.
+    void dispatch(Lane lane,
+                  RequestTracer::EndpointStats& endpoint,
+                  std::function<QNetworkReply*()> send,
+                  std::function<void(QNetworkReply*)> onFinished,
+                  const QString& tag = QString(),
+                  std::function<void()> onDropped = {});
+
+    struct PendingRequest
+    {
+        Lane lane;
+        RequestTracer::EndpointStats* endpoint;
+        std::function<QNetworkReply*()> send;
+        std::function<void(QNetworkReply*)> onFinished;
+        QString tag;
+        std::function<void()> onDropped;
+    };
+    void enqueueAttempt(std::shared_ptr<const PendingRequest> request, int attempt, int delayMs);
+
+    // ---- Typed requests on top of dispatch() ----
+    // Every endpoint goes through request() or paginate(), which own the reply and apply
+    // the same rules: stale issue reads are dropped, 401/403 become AuthFailed (and
+    // authenticationRequired when `authAction` is set), other failures are reported through
+    // operationFailed, and bodies are parsed on m_parsePool.
+
+    enum class Outcome
+    {
+        Ok,
+        NotModified, // 304 to a hand-made conditional request
+        Cancelled,   // aborted, dropped by tag, or the issue is no longer viewed
+        AuthFailed,
+        Failed
+    };
+
+    struct Call
+    {
+        Lane lane{Lane::Interactive};
+        QString endpoint;   // m_tracer statistics
+        QString context;    // operationFailed context; `endpoint` if empty
+        QString authAction; // "loading comments" -> authenticationRequired on 401/403
+        // Reads for the viewed issue: tracked for setActiveIssue() and skipped or
+        // cancelled once isStale(issueKey, generation).
+        QString issueKey;
+        quint64 generation{0};
+        QString tag;
+        bool reportErrors{true};
+    };
+
+    template <typename T>
+    struct Response
+    {
+        Outcome outcome{Outcome::Failed};
+        std::optional<T> value; // set when Ok
+        int httpStatus{0};
+        QString error; // set when Failed
+        QByteArray etag;
+        QByteArray lastModified;
+    };
+
+    // Where a page starts: an offset (startAt/total endpoints) or a nextPageToken.
+    struct PageCursor
+    {
+        int startAt{0};
+        QString token;
+    };
+
+    template <typename Item>
+    struct Page
+    {
+        QList<Item> items;
+        std::optional<PageCursor> next; // empty on the last page
+        int total{-1};
+        int step{0}; // offset between pages as the server applied it (offset listings)
+    };
+
+    // One paginate() run. Pages are numbered in request order and handed to onPage in
+    // that order, whatever order they arrive in.
+    template <typename Item>
+    struct Pager
+    {
+        Call call;
+        std::function<QNetworkReply*(const PageCursor&)> send;
+        std::function<std::optional<Page<Item>>(const QByteArray&, const PageCursor&)> parse;
+        std::function<std::optional<PageCursor>(const QByteArray&)> peek;
+        std::function<void(const QList<Item>&)> onPage;
+        std::function<void(Outcome)> onDone;
+
+        QHash<int, PageCursor> cursors; // by page number
+        QHash<int, Page<Item>> arrived; // parsed, waiting for earlier pages
+        QList<PageCursor> planned;      // offset pages known from `total`, not yet requested
+        int issued{0};
+        int delivered{0};
+        int inFlight{0};
+        quint64 epoch{0}; // bumped to disown pages requested on a wrong guess
+        bool finished{false};
+    };
+
+    // `parse` runs on m_parsePool (must not touch members); without one the body is
+    // ignored. `received` sees the raw body on the GUI thread before parsing starts.
+    // `done` runs once, on the GUI thread, unless `send` skipped the request.
+    template <typename T>
+    void request(const Call& call,
+                 std::function<QNetworkReply*()> send,
+                 std::function<std::optional<T>(const QByteArray&)> parse,
+                 std::function<void(const Response<T>&)> done,
+                 std::function<void(const QByteArray&)> received = {});
+
+    // Requests pages until one has no `next`. onPage gets each page in order as soon as
+    // the pages before it are in; onDone runs once with Ok after the last page or with
+    // the first failure.
+    //
+    // Pages are pipelined: once the first page of an offset listing reports `total`, the
+    // rest are requested together (at most kMaxPagesInFlight at a time). Token listings
+    // cannot know later tokens, but `peek` may pull the next cursor out of the raw body
+    // so that page is fetched while the current one parses.
+    template <typename Item>
+    void paginate(const Call& call,
+                  std::function<QNetworkReply*(const PageCursor&)> send,
+                  std::function<std::optional<Page<Item>>(const QByteArray&, const PageCursor&)> parse,
+                  std::function<void(const QList<Item>&)> onPage,
+                  std::function<void(Outcome)> onDone,
+                  std::function<std::optional<PageCursor>(const QByteArray&)> peek = {});
+    template <typename Item>
+    void requestPage(std::shared_ptr<Pager<Item>> pager, int index, const PageCursor& at);
+    template <typename Item>
+    void deliverPages(std::shared_ptr<Pager<Item>> pager);
+
+    static constexpr int kMaxPagesInFlight = 4;
+
+    // A write to `issueKey`: drops its cached GETs, reports `successMessage` and runs `then`.
+    void write(const Call& call, const QString& issueKey, std::function<QNetworkReply*()> send,
+               const QString& successMessage, std::function<void()> then = {});
+
+    // Field edits not sent yet, merged per issue; `fields` is the PUT body's "fields".
+    struct StagedEdit
+    {
+        JiraFieldEdit edit;
+        QJsonObject fields;
+    };
+    void stageFieldEdit(const QString& issueKey, const JiraFieldEdit& edit, const QJsonObject& fields);
+    void sendFieldEdits(const QString& issueKey);
+    // Re-applies unconfirmed edits to a snapshot fetched while they were pending.
+    void overlayFieldEdits(const QString& issueKey, JiraIssueFieldSnapshot& snapshot) const;
+
+    // One bulk operation; each batch is one request covering its keys.
+    struct BulkRun
+    {
+        Call call;
+        std::function<QNetworkReply*(const QStringList&)> send;
+        QList<QStringList> batches;
+        qsizetype next{0};
+        int inFlight{0};
+        int done{0};
+        int total{0};
+        bool authFailed{false}; // stops issuing; the rest are reported as not attempted
+        JiraBulkResult result;
+    };
+    void runBulk(const QString& operation,
+                 const Call& call,
+                 QList<QStringList> batches,
+                 std::function<QNetworkReply*(const QStringList&)> send);
+    void issueBulkBatches(std::shared_ptr<BulkRun> run);
+    void bulkEditFields(const QString& operation, const QString& endpoint, const QStringList& issueKeys,
+                        const QJsonObject& fields);
+
+    static constexpr int kMaxBulkInFlight = 4;
+    static constexpr int kAgileBulkLimit = 50;
+
+    QHash<QString, StagedEdit> m_stagedEdits;
+    QHash<QString, JiraFieldEdit> m_sendingEdits; // PUT in flight, at most one per issue
+    QTimer m_editFlushTimer;
+
+    bool isStale(const Call& call) const;
+
     QNetworkRequest makeRequest(const QUrl& url) const;
     QByteArray authHeader() const;
     bool isAuthError(const QNetworkReply* reply, QNetworkReply::NetworkError err) const;
 
-    // Jira wants Atlassian Document Format (ADF) for description/comments.
-    static QJsonObject buildAdfDocument(const QString& plainText);
-    static QString adfToPlainText(const QJsonValue& adf);
+    void trackIssueReply(const QString& issueKey, QNetworkReply* reply);
+    bool isStale(const QString& issueKey, quint64 generation = 0) const;
+
+    QString m_activeIssueKey;
+    QHash<QString, QList<QPointer<QNetworkReply>>> m_issueReplies;
+    QHash<QString, quint64> m_issueGenerations;
 
     QString m_instanceUrl;
     QString m_username;
@@ -73,20 +340,109 @@ private:
     QString m_basePlatform;
     QString m_baseAgile;
 
+    // Declared before m_net and m_parsePool so it outlives their replies and parse jobs.
+    RequestTracer m_tracer;
+
     QNetworkAccessManager m_net;
+    HttpCache* m_httpCache{nullptr}; // owned by m_net
+    RequestScheduler m_scheduler;
+    RetryPolicy m_retryPolicy;
+    quint64 m_sprintScanGeneration{0};
+
+    AgileCache m_agileCache;
+    QString m_agileCacheIdentity;
+
+    // Best active scrum sprint from m_agileCache. False if some board's sprints were never
+    // fetched; `fresh` is set when every entry involved is within its TTL.
+    bool cachedMostRecentActiveSprint(std::optional<JiraSprint>& best, bool* fresh = nullptr) const;
+    void emitMostRecentActiveSprint(const std::optional<JiraSprint>& sprint);
 
-    // Lazy field metadata (story points + sprint custom field ids)
+    // Lazy field metadata (story points + sprint custom field ids). Persisted per instance
+    // URL in fieldcache.json; a persisted copy is revalidated once per session.
     bool m_fieldMetadataLoaded{false};
+    bool m_fieldMetadataRevalidated{false};
+    bool m_fieldMetadataInFlight{false};
+    quint64 m_fieldMetadataGeneration{0};
+    QList<std::function<void()>> m_fieldMetadataWaiters;
+    FieldCacheEntry m_fieldCache;
     QString m_sprintFieldId;
     QString m_storyPointsFieldId;
 
     void ensureFieldMetadata(std::function<void()> cont);
+    void fetchFieldMetadata();
+
+    // POST /search/jql paginated via nextPageToken. onPage gets each page's tickets;
+    // onDone(complete, authFailed) runs once after the last page or the first failure.
+    void searchTickets(Lane lane,
+                       const QString& jql,
+                       const QJsonArray& fields,
+                       int maxResults,
+                       const QString& context,
+                       std::function<void(const QList<JiraTicket>&)> onPage,
+                       std::function<void(bool, bool)> onDone);
+    QJsonArray ticketSearchFields() const;
+
+    // Response bodies are parsed on m_parsePool and handed back to the GUI thread through
+    // QFuture continuations, so these must stay static and free of member state.
+    QThreadPool m_parsePool;
+
+    // QtConcurrent::run on m_parsePool, timed as the Parse phase of `endpoint`.
+    template <typename Fn>
+    auto parseAsync(RequestTracer::EndpointStats& endpoint, Fn fn)
+    {
+        return QtConcurrent::run(&m_parsePool, [this, stats = &endpoint, fn]() {
+            const qint64 start = m_tracer.now();
+            auto result = fn();
+            m_tracer.record(*stats, RequestTracer::Phase::Parse, start, m_tracer.now() - start);
+            return result;
+        });
+    }
+
+    struct FieldIds { QString sprint; QString storyPoints; };
+
+    static std::optional<FieldIds> parseFieldMetadata(const QByteArray& data);
+    static std::optional<Page<JiraTicket>> parseSearchPage(const QByteArray& data, const QString& sprintFieldId);
+    // nextPageToken read straight from the raw body, without parsing the issues.
+    static std::optional<PageCursor> peekNextPageToken(const QByteArray& data);
+    static std::optional<Page<JiraTicket>> parseSprintIssuesPage(const QByteArray& data, const PageCursor& at);
+    static std::optional<JiraIssueFieldSnapshot> parseFieldSnapshot(const QByteArray& data,
+                                                                    const QString& storyPointsFieldId,
+                                                                    const QString& sprintFieldId);
+    static std::optional<Page<JiraComment>> parseCommentsPage(const QByteArray& data, const PageCursor& at);
+    // Agile listings ("values" + "isLast").
+    template <typename Item>
+    static std::optional<Page<Item>> parseValuesPage(const QByteArray& data, const PageCursor& at,
+                                                     Item (*fromJson)(const QJsonObject&));
+    static std::optional<QList<JiraHistoryEntry>> parseHistory(const QByteArray& data);
+    static std::optional<QList<JiraTransition>> parseTransitions(const QByteArray& data);
+
+    // Details plus whether the embedded comment page was truncated.
+    struct DetailsResult { JiraIssueDetails details; bool commentsTruncated{false}; };
+    static std::optional<DetailsResult> parseIssueDetails(const QByteArray& data,
+                                                          const QString& issueKey,
+                                                          const QString& storyPointsFieldId,
+                                                          const QString& sprintFieldId);
+
+    static JiraTicket ticketFromIssue(const QJsonObject& issue, const QString& sprintFieldId);
+    static JiraIssueFieldSnapshot snapshotFromFields(const QJsonObject& fields,
+                                                     const QString& storyPointsFieldId,
+                                                     const QString& sprintFieldId);
+    static JiraComment commentFromJson(const QJsonObject& comment);
+    static QList<JiraHistoryEntry> historyFromChangelog(const QJsonObject& changelog);
+    static QList<JiraTransition> transitionsFromJson(const QJsonArray& transitions);
+    static JiraBoard boardFromJson(const QJsonObject& board);
+    static JiraSprint sprintFromJson(const QJsonObject& sprint);
 
     // Helpers used by multiple calls
     static QString parseSprintNameFromLegacyString(const QString& raw);
-    static void extractSprint(const QJsonValue& element, std::optional<int>& id, QString& name);
+    static void extractSprint(const QJsonValue& element, std::optional<int>& id, InternedString& name);
 
     void resolveUserAccountId(const QString& query, std::function<void(const QString&)> cont);
-    void getAllBoards(const QString& type, std::function<void(const QList<QJsonObject>&)> cont);
-    void getBoardSprints(int boardId, const QString& state, std::function<void(const QList<QJsonObject>&)> cont);
+    // cont(boards, complete) runs once, unless the scan is cancelled via `tag`.
+    void getAllBoards(const QString& type, const QString& tag, std::function<void(const QList<JiraBoard>&, bool)> cont);
+    // cont(sprints, complete, authFailed) runs exactly once, also when cancelled via `tag`.
+    void getBoardSprints(int boardId,
+                         const QString& state,
+                         const QString& tag,
+                         std::function<void(const QList<JiraSprint>&, bool, bool)> cont);
 };
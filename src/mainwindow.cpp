@@ -1,27 +1,37 @@
 #include "mainwindow.h"
 
+#include "adftextmapper.h"
 #include "config.h"
 #include "datahub.h"
 #include "error.h"
 #include "jira_client.h"
 #include "settingsdialog.h"
+#include "tracedock.h"
+#include "ticketsfilterproxy.h"
 #include "ticketsmodel.h"
 #include "ui_mainwindow.h"
 
+#include <QAbstractItemView>
 #include <QAction>
 #include <QApplication>
 #include <QComboBox>
+#include <QCompleter>
 #include <QDesktopServices>
 #include <QHBoxLayout>
 #include <QInputDialog>
+#include <QItemSelectionModel>
 #include <QLabel>
 #include <QListWidget>
 #include <QMenu>
 #include <QMessageBox>
 #include <QPushButton>
 #include <QSet>
+#include <QStringListModel>
 #include <QTextEdit>
+#include <QTimer>
+#include <QToolButton>
 #include <QLineEdit>
+#include <QMenuBar>
 #include <QTreeView>
 #include <QUrl>
 #include <QWidget>
@@ -32,6 +42,7 @@ MainWindow::MainWindow(QWidget* parent)
       m_client(new JiraClient(this)),
       m_hub(new DataHub(m_client, this)),
       m_ticketsModel(new TicketsModel(this)),
+      m_ticketsProxy(new TicketsFilterProxyModel(m_ticketsModel, this)),
       m_tray(nullptr)
 {
     ui->setupUi(this);
@@ -41,20 +52,29 @@ MainWindow::MainWindow(QWidget* parent)
     // Wire-up hub -> model
     connect(m_hub, &DataHub::ticketsUpdated, this, [this](const QList<JiraTicket>& tickets) {
         m_ticketsModel->setTickets(tickets);
-        // Populate status filter
+        // Populate filter menus from the store's indexes rather than walking every ticket.
         QSet<QString> statuses;
-        for (const auto& t : tickets) statuses.insert(t.status);
-        auto current = m_statusFilter->currentText();
-        m_statusFilter->blockSignals(true);
-        m_statusFilter->clear();
-        m_statusFilter->addItem("All");
-        for (const auto& s : statuses.values()) m_statusFilter->addItem(s);
-        m_statusFilter->setCurrentText(current.isEmpty() ? "All" : current);
-        m_statusFilter->blockSignals(false);
+        QSet<QString> sprints;
+        for (const auto& status : m_hub->tickets().distinctStatuses())
+            statuses.insert(status.toString());
+        for (const auto& sprint : m_hub->tickets().distinctSprints())
+            sprints.insert(sprint.isEmpty() ? QStringLiteral("No Sprint") : sprint.toString());
+        populateFilterMenu(m_statusFilter, statuses);
+        populateFilterMenu(m_sprintFilter, sprints);
     });
+    connect(m_hub, &DataHub::ticketsBatch, m_ticketsModel, &TicketsModel::mergeTickets);
 
     connect(m_client, &JiraClient::operationFailed, this, [this](const QString& ctx, const QString& err) {
+        // showError() runs a nested event loop; failures arriving meanwhile (a burst that
+        // ran out of retries) go to the status bar instead of stacking dialogs.
+        if (m_showingError)
+        {
+            statusBar()->showMessage(ctx + ": " + err, 5000);
+            return;
+        }
+        m_showingError = true;
         ErrorService::showError(ctx, err, this);
+        m_showingError = false;
     });
 
     connect(m_client, &JiraClient::authenticationRequired, this, [this](const QString& msg) {
@@ -63,79 +83,65 @@ MainWindow::MainWindow(QWidget* parent)
         openSettingsDialog(msg);
     });
 
+    // Field edits show up locally as they are made and the client refetches what other
+    // writes change, so there is nothing to reload here.
     connect(m_client, &JiraClient::operationSucceeded, this, [this](const QString& msg) {
         statusBar()->showMessage(msg, 3000);
+    });
 
-        // After writes, refresh the currently selected ticket details.
-        const auto key = m_selectedKey ? m_selectedKey->text() : QString();
-        if (!key.isEmpty() && !key.startsWith('('))
+    // Results for anything but the selected ticket are late arrivals; ignore them.
+    connect(m_client, &JiraClient::issueDetailsReady, this, [this](const JiraIssueDetails& d) {
+        if (d.key != m_selectedKey->text()) return;
+        // A failed refresh carries no details; keep showing what the cache had.
+        if (!d.valid && m_hub->cachedDetails(d.key))
         {
-            m_client->getIssueFieldSnapshot(key);
-            m_client->getIssueComments(key);
-            m_client->getIssueHistory(key);
-            m_client->getTransitions(key);
+            statusBar()->showMessage(QString("Could not refresh %1; showing cached details").arg(d.key), 5000);
+            showTransitions(d.transitions);
+            return;
         }
+        showFieldSnapshot(d.fields);
+        showComments(d.comments);
+        showHistory(d.history);
+        showTransitions(d.transitions);
     });
 
-    connect(m_client, &JiraClient::issueFieldSnapshotReady, this, [this](const JiraIssueFieldSnapshot& s) {
-        m_description->setPlainText(s.description);
-        if (s.storyPoints.has_value())
-            m_storyPoints->setText(QString::number(*s.storyPoints));
-        else
-            m_storyPoints->clear();
-
-        m_assignee->setText(s.assigneeDisplayName.isEmpty() ? s.assigneeAccountId : s.assigneeDisplayName);
-        if (s.sprintId.has_value())
-            m_sprintId->setText(QString::number(*s.sprintId));
-        else
-            m_sprintId->clear();
-        m_currentSprintName->setText(s.sprintName.isEmpty() ? QString() : ("Current: " + s.sprintName));
-
-        if (s.dueDate.has_value())
-            m_dueDate->setDate(*s.dueDate);
+    connect(m_client, &JiraClient::issueFieldSnapshotReady, this, [this](const QString& key, const JiraIssueFieldSnapshot& s, bool complete) {
+        if (key != m_selectedKey->text()) return;
+        const auto* cached = complete ? nullptr : m_hub->cachedDetails(key);
+        showFieldSnapshot(cached ? cached->fields : s);
+    });
+    connect(m_hub, &DataHub::issueFieldsReverted, this, [this](const QString& key, const JiraIssueFieldSnapshot& s) {
+        if (key != m_selectedKey->text()) return;
+        showFieldSnapshot(s);
+    });
+    connect(m_hub, &DataHub::issueSprintChanged, this, [this](const QString& key, const JiraIssueFieldSnapshot& s) {
+        if (key != m_selectedKey->text()) return;
+        showSprint(s);
     });
 
-    connect(m_client, &JiraClient::issueCommentsReady, this, [this](const QList<JiraComment>& comments) {
-        m_comments->clear();
-        if (comments.isEmpty())
-        {
-            m_comments->addItem("(no comments)");
-            return;
-        }
-        for (const auto& c : comments)
-        {
-            const auto header = QString("%1 (%2)").arg(c.author, c.created.isValid() ? c.created.toString("yyyy-MM-dd HH:mm") : "");
-            auto* item = new QListWidgetItem(header + "\n" + c.editableBody, m_comments);
-            item->setData(Qt::UserRole, c.id);
-            item->setData(Qt::UserRole + 1, c.editableBody);
-        }
+    connect(m_client, &JiraClient::issueCommentsReady, this, [this](const QString& key, const QList<JiraComment>& comments, bool complete) {
+        if (key != m_selectedKey->text()) return;
+        // A failed refetch falls back to the last complete thread rather than a partial one.
+        const auto* cached = complete ? nullptr : m_hub->cachedDetails(key);
+        showComments(cached ? cached->comments : comments);
+    });
+    connect(m_client, &JiraClient::issueCommentsLoading, this, [this](const QString& key, const QList<JiraComment>& comments) {
+        if (key != m_selectedKey->text()) return;
+        showComments(comments);
     });
 
-    connect(m_client, &JiraClient::issueHistoryReady, this, [this](const QList<JiraHistoryEntry>& entries) {
-        m_history->clear();
-        if (entries.isEmpty())
-        {
-            m_history->addItem("(no history)" );
-            return;
-        }
-        for (const auto& e : entries)
-        {
-            const auto line = QString("%1 (%2): Changed %3 from '%4' to '%5'")
-                .arg(e.author,
-                     e.when.isValid() ? e.when.toString("yyyy-MM-dd HH:mm") : "",
-                     e.field,
-                     e.fromValue.isEmpty() ? "(empty)" : e.fromValue,
-                     e.toValue.isEmpty() ? "(empty)" : e.toValue);
-            m_history->addItem(line);
-        }
+    connect(m_client, &JiraClient::issueHistoryReady, this, [this](const QString& key, const QList<JiraHistoryEntry>& entries, bool complete) {
+        if (key != m_selectedKey->text()) return;
+        const auto* cached = complete ? nullptr : m_hub->cachedDetails(key);
+        showHistory(cached ? cached->history : entries);
     });
 
-    connect(m_client, &JiraClient::transitionsReady, this, [this](const QList<JiraTransition>& transitions) {
-        m_transitions->clear();
-        m_transitions->addItem("(select)", QString());
-        for (const auto& t : transitions)
-            m_transitions->addItem(t.name, t.id);
+    connect(m_client, &JiraClient::transitionsReady, this, &MainWindow::showTransitions);
+
+    connect(m_client, &JiraClient::bulkProgress, this, [this](const QString& operation, int done, int total) {
+        statusBar()->showMessage(QString("%1: %2 of %3 tickets...").arg(operation).arg(done).arg(total));
     });
+    connect(m_client, &JiraClient::bulkFinished, this, &MainWindow::showBulkResult);
 
     loadConfig();
     if (ensureConfigured("Jira setup is required before loading tickets."))
@@ -170,19 +176,38 @@ void MainWindow::setupUi()
     m_comments = ui->listComments;
     m_history = ui->listHistory;
 
-    auto statusFilterWidget = new QWidget(ui->toolBar);
-    auto statusLayout = new QHBoxLayout(statusFilterWidget);
-    statusLayout->setContentsMargins(0, 0, 0, 0);
-    statusLayout->setSpacing(6);
-    auto statusLabel = new QLabel("Filter by Status:", statusFilterWidget);
-    m_statusFilter = new QComboBox(statusFilterWidget);
-    m_statusFilter->addItem("All");
-    statusLayout->addWidget(statusLabel);
-    statusLayout->addWidget(m_statusFilter);
-    ui->toolBar->addWidget(statusFilterWidget);
+    auto filterWidget = new QWidget(ui->toolBar);
+    auto filterLayout = new QHBoxLayout(filterWidget);
+    filterLayout->setContentsMargins(0, 0, 0, 0);
+    filterLayout->setSpacing(6);
+    auto filterLabel = new QLabel("Filter:", filterWidget);
+    m_statusFilter = new QToolButton(filterWidget);
+    m_statusFilter->setProperty("filterName", "Status");
+    m_sprintFilter = new QToolButton(filterWidget);
+    m_sprintFilter->setProperty("filterName", "Sprint");
+    for (auto* button : {m_statusFilter, m_sprintFilter})
+    {
+        button->setPopupMode(QToolButton::InstantPopup);
+        button->setMenu(new QMenu(button));
+        button->setText(button->property("filterName").toString() + ": All");
+    }
+    m_textFilter = new QLineEdit(filterWidget);
+    m_textFilter->setPlaceholderText("Search tickets, descriptions, comments");
+    m_textFilter->setClearButtonEnabled(true);
+    filterLayout->addWidget(filterLabel);
+    filterLayout->addWidget(m_statusFilter);
+    filterLayout->addWidget(m_sprintFilter);
+    filterLayout->addWidget(m_textFilter);
+    ui->toolBar->addWidget(filterWidget);
     ui->toolBar->setStyleSheet(QString());
 
     m_description->setPlaceholderText("Select a ticket to load description...");
+    m_descriptionMapper = new AdfTextMapper(m_description->document(), this);
+    // Large descriptions render over several event loop turns; no edits until done.
+    connect(m_descriptionMapper, &AdfTextMapper::loadFinished, this, [this] {
+        m_description->setReadOnly(false);
+        ui->buttonSaveDescription->setEnabled(true);
+    });
 
     ui->splitterDescDetails->setStretchFactor(0, 3);
     ui->splitterDescDetails->setStretchFactor(1, 1);
@@ -196,26 +221,46 @@ void MainWindow::setupUi()
     connect(ui->actionQuit, &QAction::triggered, qApp, &QApplication::quit);
     connect(ui->actionRefresh, &QAction::triggered, this, &MainWindow::refreshTickets);
 
-    connect(m_statusFilter, &QComboBox::currentTextChanged, this, [this](const QString& text) {
-        // Very simple filter: refetch and rebuild model, removing tickets not matching.
-        // If you want a richer experience, use QSortFilterProxyModel.
-        auto tickets = m_hub->currentTickets();
-        if (text != "All")
-        {
-            QList<JiraTicket> filtered;
-            for (const auto& t : tickets)
-                if (t.status == text)
-                    filtered.append(t);
-            m_ticketsModel->setTickets(filtered);
-        }
-        else
-        {
-            m_ticketsModel->setTickets(tickets);
-        }
+    m_traceDock = new TraceDock(m_client->tracer(), this);
+    addDockWidget(Qt::BottomDockWidgetArea, m_traceDock);
+    m_traceDock->hide();
+    auto* viewMenu = menuBar()->addMenu("&View");
+    viewMenu->addAction(m_traceDock->toggleViewAction());
+
+    // Attached with setWidget() rather than QLineEdit::setCompleter() so picking a hit
+    // jumps to the ticket instead of overwriting the query.
+    m_searchResults = new QStringListModel(this);
+    m_searchCompleter = new QCompleter(m_searchResults, this);
+    m_searchCompleter->setWidget(m_textFilter);
+    m_searchCompleter->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+    m_searchCompleter->setMaxVisibleItems(12);
+    connect(m_searchCompleter, qOverload<const QString&>(&QCompleter::activated), this, [this](const QString& text) {
+        selectTicket(text.section(' ', 0, 0));
+    });
+    connect(m_textFilter, &QLineEdit::textEdited, this, [this] { runSearch(true); });
+    connect(m_textFilter, &QLineEdit::textChanged, this, [this](const QString& text) {
+        // Covers the clear button, which does not emit textEdited.
+        if (text.isEmpty()) runSearch(false);
+    });
+    connect(m_hub, &DataHub::searchIndexUpdated, this, [this] {
+        if (!m_textFilter->text().trimmed().isEmpty()) runSearch(false);
     });
 
-    m_tree->setModel(m_ticketsModel);
-    connect(m_tree, &QTreeView::clicked, this, &MainWindow::onTicketSelected);
+    m_tree->setModel(m_ticketsProxy);
+    connect(m_tree, &QTreeView::clicked, this, &MainWindow::onTicketClicked);
+    connect(m_tree->selectionModel(), &QItemSelectionModel::currentChanged, this, [this](const QModelIndex& current) {
+        onTicketSelected(current);
+    });
+    connect(m_tree->selectionModel(), &QItemSelectionModel::selectionChanged, this, [this] {
+        const auto count = selectedKeys().size();
+        if (count > 1)
+            statusBar()->showMessage(QString("%1 tickets selected").arg(count));
+    });
+
+    m_detailsDebounce = new QTimer(this);
+    m_detailsDebounce->setSingleShot(true);
+    m_detailsDebounce->setInterval(150);
+    connect(m_detailsDebounce, &QTimer::timeout, this, &MainWindow::loadSelectedDetails);
 
     connect(m_openInJira, &QPushButton::clicked, this, [this] {
         if (!ensureConfigured("Jira setup is required before opening issues in Jira."))
@@ -229,34 +274,75 @@ void MainWindow::setupUi()
         QDesktopServices::openUrl(QUrl(b + "/browse/" + key));
     });
 
+    // With several tickets selected the field and transition buttons apply to all of them;
+    // the details pane keeps showing the current one.
     connect(m_applyTransition, &QPushButton::clicked, this, [this] {
         const auto key = m_selectedKey->text();
         if (key.startsWith('(')) return;
         const auto id = m_transitions->currentData().toString();
         if (id.isEmpty()) return;
+        const auto keys = selectedKeys();
+        if (keys.size() > 1)
+        {
+            if (confirmBulk("Apply \"" + m_transitions->currentText() + "\"", keys.size()))
+                m_client->bulkTransition(keys, id);
+            return;
+        }
         m_client->transitionIssue(key, id);
     });
 
     connect(ui->buttonSaveDescription, &QPushButton::clicked, this, [this] {
         const auto key = m_selectedKey->text();
-        if (key.startsWith('(')) return;
-        m_client->updateIssueDescription(key, m_description->toPlainText());
+        if (key.startsWith('(') || m_descriptionMapper->isLoading()) return;
+        if (!m_description->document()->isModified())
+        {
+            statusBar()->showMessage("Description unchanged", 3000);
+            return;
+        }
+        const auto adf = m_descriptionMapper->toAdf();
+        m_client->updateIssueDescription(key, adf);
+        // The edit is staged; what was sent is the baseline for the next save. A refused
+        // save reloads the description through issueFieldsReverted.
+        m_descriptionMapper->commit(adf);
     });
 
     connect(m_updateStoryPoints, &QPushButton::clicked, this, [this] {
         const auto key = m_selectedKey->text();
         if (key.startsWith('(')) return;
         const auto t = m_storyPoints->text().trimmed();
-        if (t.isEmpty()) { m_client->updateStoryPoints(key, std::nullopt); return; }
+        if (t.isEmpty())
+        {
+            const auto keys = selectedKeys();
+            if (keys.size() <= 1)
+                m_client->updateStoryPoints(key, std::nullopt);
+            else if (confirmBulk("Clear story points", keys.size()))
+                m_client->bulkUpdateStoryPoints(keys, std::nullopt);
+            return;
+        }
         bool ok = false;
         const double v = t.toDouble(&ok);
         if (!ok) { ErrorService::showError("Story Points", "Enter a number or leave blank to clear", this); return; }
+        const auto keys = selectedKeys();
+        if (keys.size() > 1)
+        {
+            if (confirmBulk("Set story points to " + t, keys.size()))
+                m_client->bulkUpdateStoryPoints(keys, v);
+            return;
+        }
         m_client->updateStoryPoints(key, v);
     });
 
     connect(m_updateAssignee, &QPushButton::clicked, this, [this] {
         const auto key = m_selectedKey->text();
         if (key.startsWith('(')) return;
+        const auto keys = selectedKeys();
+        if (keys.size() > 1)
+        {
+            const auto who = m_assignee->text().trimmed();
+            if (confirmBulk(who.isEmpty() ? QString("Unassign") : "Assign to " + who, keys.size()))
+                m_client->bulkUpdateAssignee(keys, who);
+            return;
+        }
         m_client->updateAssignee(key, m_assignee->text());
     });
 
@@ -264,18 +350,37 @@ void MainWindow::setupUi()
         const auto key = m_selectedKey->text();
         if (key.startsWith('(')) return;
         const auto t = m_sprintId->text().trimmed();
-        if (t.isEmpty()) { m_client->updateSprint(key, std::nullopt); return; }
-        bool ok = false;
-        const int v = t.toInt(&ok);
-        if (!ok) { ErrorService::showError("Sprint", "Enter a numeric sprint id or leave blank to clear", this); return; }
-        m_client->updateSprint(key, v);
+        std::optional<int> sprintId;
+        if (!t.isEmpty())
+        {
+            bool ok = false;
+            sprintId = t.toInt(&ok);
+            if (!ok) { ErrorService::showError("Sprint", "Enter a numeric sprint id or leave blank to clear", this); return; }
+        }
+        const auto keys = selectedKeys();
+        if (keys.size() > 1)
+        {
+            if (confirmBulk(sprintId ? "Move to sprint " + t : QString("Move to the backlog"), keys.size()))
+                m_client->bulkMoveToSprint(keys, sprintId);
+            return;
+        }
+        m_client->updateSprint(key, sprintId);
     });
 
     connect(m_updateDueDate, &QPushButton::clicked, this, [this] {
         const auto key = m_selectedKey->text();
         if (key.startsWith('(')) return;
-        if (!m_dueDate->date().isValid()) { m_client->updateDueDate(key, std::nullopt); return; }
-        m_client->updateDueDate(key, m_dueDate->date());
+        std::optional<QDate> dueDate;
+        if (m_dueDate->date().isValid())
+            dueDate = m_dueDate->date();
+        const auto keys = selectedKeys();
+        if (keys.size() > 1)
+        {
+            if (confirmBulk(dueDate ? "Set due date to " + dueDate->toString(Qt::ISODate) : QString("Clear due date"), keys.size()))
+                m_client->bulkUpdateDueDate(keys, dueDate);
+            return;
+        }
+        m_client->updateDueDate(key, dueDate);
     });
 
     connect(ui->buttonPostComment, &QPushButton::clicked, this, [this] {
@@ -343,6 +448,10 @@ void MainWindow::loadConfig()
 void MainWindow::applyConfig(const AppConfig& cfg)
 {
     m_client->configure(cfg.jira.instanceUrl, cfg.jira.username, cfg.jira.apiToken);
+    m_client->setMaxConcurrentRequests(cfg.network.maxConcurrentRequests);
+    m_client->setHttpCacheSize(qint64(cfg.network.httpCacheMaxMB) * 1024 * 1024);
+    // Paints the cached tree for this account (if any) before the first refresh completes.
+    m_hub->openCache(cfg.jira.instanceUrl.trimmed() + "|" + cfg.jira.username.trimmed());
 }
 
 bool MainWindow::isConfigComplete() const
@@ -401,40 +510,273 @@ void MainWindow::refreshTickets()
     m_hub->refreshMyTickets();
 }
 
-void MainWindow::onTicketSelected(const QModelIndex& idx)
+void MainWindow::onTicketClicked(const QModelIndex& viewIdx)
+{
+    // Expand/collapse group nodes.
+    if (m_ticketsProxy->data(viewIdx, TicketsModel::RoleType).toString() == "group")
+        m_tree->setExpanded(viewIdx, !m_tree->isExpanded(viewIdx));
+}
+
+void MainWindow::onTicketSelected(const QModelIndex& viewIdx)
 {
+    const auto idx = m_ticketsProxy->mapToSource(viewIdx);
     const auto key = m_ticketsModel->ticketKeyForIndex(idx);
     if (key.isEmpty())
-    {
-        // Expand/collapse group nodes.
-        if (m_ticketsModel->data(idx, TicketsModel::RoleType).toString() == "group")
-        {
-            m_tree->setExpanded(idx, !m_tree->isExpanded(idx));
-        }
-        return;
-    }
-
-    if (!ensureConfigured("Jira setup is required before loading ticket details."))
         return;
 
     m_selectedKey->setText(key);
     m_selectedStatus->setText(m_ticketsModel->data(idx, TicketsModel::RoleStatus).toString());
 
     m_selectedSummary->setText(m_ticketsModel->data(idx, TicketsModel::RoleSummary).toString());
-    m_description->setPlainText("Loading...");
+
+    // Drop whatever is still loading for the previous ticket before anything else.
+    m_client->setActiveIssue(key);
 
     m_transitions->clear();
     m_transitions->addItem("(loading)", QString());
 
+    // Show the last known details right away; the request below revalidates them.
+    if (const auto* cached = m_hub->cachedDetails(key))
+    {
+        showFieldSnapshot(cached->fields);
+        showComments(cached->comments);
+        showHistory(cached->history);
+    }
+    else
+    {
+        m_descriptionMapper->clear();
+        m_description->setPlainText("Loading...");
+        m_description->setReadOnly(true);
+        ui->buttonSaveDescription->setEnabled(false);
+
+        m_comments->clear();
+        m_comments->addItem("Loading...");
+
+        m_history->clear();
+        m_history->addItem("Loading...");
+    }
+
+    // Debounced so holding an arrow key only loads the ticket it stops on.
+    m_detailsDebounce->start();
+}
+
+QStringList MainWindow::selectedKeys() const
+{
+    QStringList keys;
+    for (const auto& viewIdx : m_tree->selectionModel()->selectedRows())
+    {
+        // Group rows are skipped: clicking one to expand it selects it too.
+        const auto key = m_ticketsModel->ticketKeyForIndex(m_ticketsProxy->mapToSource(viewIdx));
+        if (!key.isEmpty())
+            keys.append(key);
+    }
+    return keys;
+}
+
+bool MainWindow::confirmBulk(const QString& action, qsizetype count)
+{
+    return QMessageBox::question(this, "Bulk update", QString("%1 for %2 selected tickets?").arg(action).arg(count))
+        == QMessageBox::Yes;
+}
+
+void MainWindow::showBulkResult(const JiraBulkResult& result)
+{
+    const auto total = result.succeeded.size() + result.failed.size();
+    statusBar()->showMessage(QString("%1: %2 of %3 tickets updated").arg(result.operation).arg(result.succeeded.size()).arg(total),
+                             5000);
+
+    // The ticket list itself is refreshed once by DataHub.
+    const auto key = m_selectedKey->text();
+    if (result.succeeded.contains(key))
+        m_client->getIssueDetails(key);
+
+    if (result.failed.isEmpty() || m_showingError)
+        return;
+
+    constexpr qsizetype kMaxListed = 20;
+    QStringList lines;
+    for (qsizetype i = 0; i < result.failed.size() && i < kMaxListed; ++i)
+        lines << result.failed[i].issueKey + ": " + result.failed[i].error;
+    if (result.failed.size() > kMaxListed)
+        lines << QString("...and %1 more").arg(result.failed.size() - kMaxListed);
+
+    m_showingError = true;
+    ErrorService::showError(result.operation,
+                            QString("%1 of %2 tickets were not updated:\n").arg(result.failed.size()).arg(total) + lines.join('\n'),
+                            this);
+    m_showingError = false;
+}
+
+void MainWindow::loadSelectedDetails()
+{
+    const auto key = m_selectedKey->text();
+    if (key.isEmpty() || key.startsWith('('))
+        return;
+
+    if (!ensureConfigured("Jira setup is required before loading ticket details."))
+        return;
+
+    m_client->getIssueDetails(key);
+}
+
+void MainWindow::showFieldSnapshot(const JiraIssueFieldSnapshot& s)
+{
+    m_description->setReadOnly(true);
+    ui->buttonSaveDescription->setEnabled(false);
+    if (!s.descriptionAdf.isEmpty())
+        m_descriptionMapper->load(s.descriptionAdf);
+    else
+        m_descriptionMapper->loadPlainText(s.description);
+    if (s.storyPoints.has_value())
+        m_storyPoints->setText(QString::number(*s.storyPoints));
+    else
+        m_storyPoints->clear();
+
+    m_assignee->setText((s.assigneeDisplayName.isEmpty() ? s.assigneeAccountId : s.assigneeDisplayName).toString());
+    showSprint(s);
+
+    if (s.dueDate.has_value())
+        m_dueDate->setDate(*s.dueDate);
+}
+
+void MainWindow::showSprint(const JiraIssueFieldSnapshot& s)
+{
+    if (s.sprintId.has_value())
+        m_sprintId->setText(QString::number(*s.sprintId));
+    else
+        m_sprintId->clear();
+    m_currentSprintName->setText(s.sprintName.isEmpty() ? QString() : ("Current: " + s.sprintName.toString()));
+}
+
+void MainWindow::showComments(const QList<JiraComment>& comments)
+{
     m_comments->clear();
-    m_comments->addItem("Loading...");
+    if (comments.isEmpty())
+    {
+        m_comments->addItem("(no comments)");
+        return;
+    }
+    for (const auto& c : comments)
+    {
+        const auto header = QString("%1 (%2)").arg(c.author.toString(), c.created.isValid() ? c.created.toString("yyyy-MM-dd HH:mm") : "");
+        auto* item = new QListWidgetItem(header + "\n" + c.editableBody, m_comments);
+        item->setData(Qt::UserRole, c.id);
+        item->setData(Qt::UserRole + 1, c.editableBody);
+    }
+}
 
+void MainWindow::showHistory(const QList<JiraHistoryEntry>& entries)
+{
     m_history->clear();
-    m_history->addItem("Loading...");
+    if (entries.isEmpty())
+    {
+        m_history->addItem("(no history)" );
+        return;
+    }
+    for (const auto& e : entries)
+    {
+        const auto line = QString("%1 (%2): Changed %3 from '%4' to '%5'")
+            .arg(e.author.toString(),
+                 e.when.isValid() ? e.when.toString("yyyy-MM-dd HH:mm") : "",
+                 e.field,
+                 e.fromValue.isEmpty() ? "(empty)" : e.fromValue,
+                 e.toValue.isEmpty() ? "(empty)" : e.toValue);
+        m_history->addItem(line);
+    }
+}
+
+void MainWindow::showTransitions(const QList<JiraTransition>& transitions)
+{
+    m_transitions->clear();
+    m_transitions->addItem("(select)", QString());
+    for (const auto& t : transitions)
+        m_transitions->addItem(t.name, t.id);
+}
+
+void MainWindow::populateFilterMenu(QToolButton* button, const QSet<QString>& values)
+{
+    auto* menu = button->menu();
+
+    QSet<QString> checked;
+    for (auto* a : menu->actions())
+        if (a->isChecked())
+            checked.insert(a->text());
+
+    QStringList sorted(values.cbegin(), values.cend());
+    sorted.sort(Qt::CaseInsensitive);
+
+    menu->clear();
+    for (const auto& v : sorted)
+    {
+        auto* a = menu->addAction(v);
+        a->setCheckable(true);
+        a->setChecked(checked.contains(v));
+        connect(a, &QAction::toggled, this, &MainWindow::applyFilters);
+    }
+    applyFilters();
+}
+
+void MainWindow::runSearch(bool showPopup)
+{
+    const auto query = m_textFilter->text().trimmed();
+    if (query.isEmpty())
+    {
+        m_ticketsProxy->setKeyFilter(std::nullopt);
+        m_searchResults->setStringList({});
+        m_searchCompleter->popup()->hide();
+        return;
+    }
+
+    m_ticketsProxy->setKeyFilter(m_hub->searchIndex().matches(query));
+
+    // Only a new query re-expands the tree; index updates keep groups as the user left them.
+    if (!showPopup)
+        return;
+    m_tree->expandAll();
+
+    constexpr int kPopupHits = 20;
+    const auto hits = m_hub->searchIndex().search(query, kPopupHits);
+    const auto& store = m_hub->tickets();
+    QStringList rows;
+    for (const auto& hit : hits)
+    {
+        const auto row = store.rowOf(hit.key);
+        rows.append(hit.key + "  " + (row < 0 ? QString() : store.summaries()[row]));
+    }
+    m_searchResults->setStringList(rows);
+    if (rows.isEmpty())
+        m_searchCompleter->popup()->hide();
+    else
+        m_searchCompleter->complete();
+}
+
+void MainWindow::selectTicket(const QString& key)
+{
+    const auto sourceIdx = m_ticketsModel->indexForKey(key);
+    const auto viewIdx = m_ticketsProxy->mapFromSource(sourceIdx);
+    if (!viewIdx.isValid())
+        return;
+    m_tree->scrollTo(viewIdx);
+    m_tree->setCurrentIndex(viewIdx);
+}
+
+void MainWindow::applyFilters()
+{
+    const auto checkedIn = [](QToolButton* button) {
+        QSet<QString> values;
+        for (auto* a : button->menu()->actions())
+            if (a->isChecked())
+                values.insert(a->text());
+        const auto name = button->property("filterName").toString();
+        if (values.isEmpty())
+            button->setText(name + ": All");
+        else if (values.size() == 1)
+            button->setText(name + ": " + *values.cbegin());
+        else
+            button->setText(QString("%1: %2 selected").arg(name).arg(values.size()));
+        return values;
+    };
 
-    // Load details
-    m_client->getIssueFieldSnapshot(key);
-    m_client->getIssueComments(key);
-    m_client->getIssueHistory(key);
-    m_client->getTransitions(key);
+    m_ticketsProxy->setStatusFilter(checkedIn(m_statusFilter));
+    m_ticketsProxy->setSprintFilter(checkedIn(m_sprintFilter));
 }
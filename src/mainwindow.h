@@ -13,6 +13,7 @@ class MainWindow;
 class DataHub;
 class JiraClient;
 class TicketsModel;
+class TicketsFilterProxyModel;
 class QTreeView;
 class QTextEdit;
 class QLabel;
@@ -21,6 +22,12 @@ class QListWidget;
 class QLineEdit;
 class QDateEdit;
 class QPushButton;
+class QTimer;
+class QToolButton;
+class QCompleter;
+class QStringListModel;
+class TraceDock;
+class AdfTextMapper;
 
 class MainWindow : public QMainWindow
 {
@@ -39,10 +46,32 @@ private:
     bool openSettingsDialog(const QString& reason);
 
     void refreshTickets();
-    void onTicketSelected(const QModelIndex& idx);
+    // Both take view (proxy) indexes.
+    void onTicketClicked(const QModelIndex& viewIdx);
+    void onTicketSelected(const QModelIndex& viewIdx);
+    void loadSelectedDetails();
+    // Tickets selected in the tree; group rows are left out.
+    QStringList selectedKeys() const;
+    bool confirmBulk(const QString& action, qsizetype count);
+    void showBulkResult(const JiraBulkResult& result);
+
+    void showFieldSnapshot(const JiraIssueFieldSnapshot& s);
+    void showSprint(const JiraIssueFieldSnapshot& s);
+    void showComments(const QList<JiraComment>& comments);
+    void showHistory(const QList<JiraHistoryEntry>& entries);
+    void showTransitions(const QList<JiraTransition>& transitions);
+
+    // Multi-select filter menus; checked entries survive repopulation.
+    void populateFilterMenu(QToolButton* button, const QSet<QString>& values);
+    void applyFilters();
+    // Runs the search box query against the local index: filters the tree to the hits
+    // and offers the best-ranked ones in a popup.
+    void runSearch(bool showPopup);
+    void selectTicket(const QString& key);
 
     AppConfig m_cfg;
     bool m_authRequired{false};
+    bool m_showingError{false};
 
     Ui::MainWindow* ui;
 
@@ -50,9 +79,14 @@ private:
     DataHub* m_hub;
 
     TicketsModel* m_ticketsModel;
+    TicketsFilterProxyModel* m_ticketsProxy;
 
     QTreeView* m_tree;
-    QComboBox* m_statusFilter;
+    QToolButton* m_statusFilter;
+    QToolButton* m_sprintFilter;
+    QLineEdit* m_textFilter;
+    QCompleter* m_searchCompleter;
+    QStringListModel* m_searchResults;
 
     QLabel* m_selectedKey;
     QLabel* m_selectedStatus;
@@ -63,6 +97,7 @@ private:
     QPushButton* m_applyTransition;
 
     QTextEdit* m_description;
+    AdfTextMapper* m_descriptionMapper;
     QLineEdit* m_storyPoints;
     QLineEdit* m_assignee;
     QLineEdit* m_sprintId;
@@ -76,5 +111,8 @@ private:
     QListWidget* m_comments;
     QListWidget* m_history;
 
+    QTimer* m_detailsDebounce;
+    TraceDock* m_traceDock;
+
     QSystemTrayIcon* m_tray;
 };
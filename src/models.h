@@ -3,28 +3,33 @@
 #include <QString>
 #include <QDateTime>
 #include <QDate>
+#include <QJsonObject>
 #include <QList>
+#include <QStringList>
 #include <optional>
 
+#include "internedstring.h"
+
 struct JiraTicket
 {
     QString key;
     QString summary;
-    QString status;
-    QString sprint;
+    InternedString status;
+    InternedString sprint;
+    QDateTime updated;
 };
 
 struct JiraComment
 {
     QString id;
-    QString author;
+    InternedString author;
     QDateTime created;
     QString editableBody; // plain text (one paragraph per line)
 };
 
 struct JiraHistoryEntry
 {
-    QString author;
+    InternedString author;
     QDateTime when;
     QString field;
     QString fromValue;
@@ -33,17 +38,113 @@ struct JiraHistoryEntry
 
 struct JiraIssueFieldSnapshot
 {
-    QString description;
+    QString description;        // plain text, for search and previews
+    QJsonObject descriptionAdf; // as sent by Jira; what the editor renders
     std::optional<double> storyPoints;
-    QString assigneeDisplayName;
-    QString assigneeAccountId;
-    QString sprintName;
+    InternedString assigneeDisplayName;
+    InternedString assigneeAccountId;
+    InternedString sprintName;
     std::optional<int> sprintId;
     std::optional<QDate> dueDate;
 };
 
+// Local effect of a field write: which snapshot members it sets and their new values.
+// Used to show edits before Jira confirms them and to undo them if it refuses.
+struct JiraFieldEdit
+{
+    enum Field
+    {
+        Description = 0x01,
+        StoryPoints = 0x02,
+        Assignee = 0x04,
+        Sprint = 0x08,
+        DueDate = 0x10,
+        All = 0x1f
+    };
+
+    int fields{0};                 // Field flags
+    JiraIssueFieldSnapshot values; // only the members named by `fields` are meaningful
+
+    bool isEmpty() const { return fields == 0; }
+
+    // Copies the members named by `fields` from `from` into `to`.
+    static void copyFields(int fields, const JiraIssueFieldSnapshot& from, JiraIssueFieldSnapshot& to)
+    {
+        if (fields & Description)
+        {
+            to.description = from.description;
+            to.descriptionAdf = from.descriptionAdf;
+        }
+        if (fields & StoryPoints)
+            to.storyPoints = from.storyPoints;
+        if (fields & Assignee)
+        {
+            to.assigneeDisplayName = from.assigneeDisplayName;
+            to.assigneeAccountId = from.assigneeAccountId;
+        }
+        if (fields & Sprint)
+        {
+            to.sprintId = from.sprintId;
+            to.sprintName = from.sprintName;
+        }
+        if (fields & DueDate)
+            to.dueDate = from.dueDate;
+    }
+
+    void applyTo(JiraIssueFieldSnapshot& snapshot) const { copyFields(fields, values, snapshot); }
+
+    // A later edit wins for the fields both touch.
+    void merge(const JiraFieldEdit& later)
+    {
+        later.applyTo(values);
+        fields |= later.fields;
+    }
+};
+
+struct JiraBulkFailure
+{
+    QString issueKey;
+    QString error;
+};
+
+// Outcome of a bulk operation: the issues it changed and why the others were not.
+struct JiraBulkResult
+{
+    QString operation; // "Move to sprint", ...
+    QStringList succeeded;
+    QList<JiraBulkFailure> failed;
+};
+
+struct JiraBoard
+{
+    int id{0};
+    QString name;
+    QString type;
+};
+
+struct JiraSprint
+{
+    int id{0};
+    QString name;
+    QString state; // future, active, closed
+    QDateTime startDate;
+    QDateTime endDate;
+};
+
 struct JiraTransition
 {
     QString id;
     QString name;
 };
+
+// Everything the details pane shows for one issue; also the unit of the on-disk cache
+// (transitions depend on the live status and are not persisted).
+struct JiraIssueDetails
+{
+    QString key;
+    JiraIssueFieldSnapshot fields;
+    QList<JiraComment> comments;
+    QList<JiraHistoryEntry> history;
+    QList<JiraTransition> transitions;
+    bool valid{false}; // false when the fetch failed; shown, but never cached
+};
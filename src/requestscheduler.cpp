@@ -0,0 +1,155 @@
+#include "requestscheduler.h"
+
+#include <QNetworkReply>
+
+#include <algorithm>
+
+RequestScheduler::RequestScheduler(QObject* parent)
+    : QObject(parent)
+{
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, [this]() {
+        releaseDelayed();
+        schedulePump();
+    });
+}
+
+void RequestScheduler::setMaxInFlight(int maxInFlight)
+{
+    m_maxInFlight = std::max(1, maxInFlight);
+    schedulePump();
+}
+
+void RequestScheduler::enqueue(Lane lane, Start start, const QString& tag, std::function<void()> dropped)
+{
+    m_queues[int(lane)].append(Job{std::move(start), tag, std::move(dropped)});
+    schedulePump();
+}
+
+void RequestScheduler::enqueueAfter(int delayMs, Lane lane, Start start, const QString& tag, std::function<void()> dropped)
+{
+    if (delayMs <= 0)
+    {
+        enqueue(lane, std::move(start), tag, std::move(dropped));
+        return;
+    }
+    m_delayed.append(Delayed{Job{std::move(start), tag, std::move(dropped)}, lane, QDeadlineTimer(delayMs)});
+    armTimer();
+}
+
+void RequestScheduler::pauseFor(int ms)
+{
+    const QDeadlineTimer until(ms);
+    if (m_pausedUntil.hasExpired() || until.deadline() > m_pausedUntil.deadline())
+        m_pausedUntil = until;
+    armTimer();
+}
+
+void RequestScheduler::releaseDelayed()
+{
+    for (auto it = m_delayed.begin(); it != m_delayed.end();)
+    {
+        if (!it->due.hasExpired())
+        {
+            ++it;
+            continue;
+        }
+        m_queues[int(it->lane)].append(std::move(it->job));
+        it = m_delayed.erase(it);
+    }
+    armTimer();
+}
+
+void RequestScheduler::armTimer()
+{
+    qint64 next = -1;
+    for (const auto& d : m_delayed)
+        next = next < 0 ? d.due.remainingTime() : std::min(next, d.due.remainingTime());
+    if (!m_pausedUntil.hasExpired())
+        next = next < 0 ? m_pausedUntil.remainingTime() : std::min(next, m_pausedUntil.remainingTime());
+
+    if (next < 0)
+        m_timer.stop();
+    else
+        m_timer.start(int(next));
+}
+
+void RequestScheduler::cancel(const QString& tag)
+{
+    if (tag.isEmpty())
+        return;
+
+    QList<Job> dropped;
+    for (auto& queue : m_queues)
+    {
+        for (auto it = queue.begin(); it != queue.end();)
+        {
+            if (it->tag != tag)
+            {
+                ++it;
+                continue;
+            }
+            dropped.append(std::move(*it));
+            it = queue.erase(it);
+        }
+    }
+    for (auto it = m_delayed.begin(); it != m_delayed.end();)
+    {
+        if (it->job.tag != tag)
+        {
+            ++it;
+            continue;
+        }
+        dropped.append(std::move(it->job));
+        it = m_delayed.erase(it);
+    }
+    armTimer();
+
+    // abort() emits finished synchronously, which edits m_running; work on a copy.
+    const auto running = m_running;
+    for (const auto& r : running)
+        if (r.tag == tag && r.reply)
+            r.reply->abort();
+
+    // Callbacks last: they may queue new work.
+    for (const auto& j : dropped)
+        if (j.dropped)
+            j.dropped();
+}
+
+void RequestScheduler::schedulePump()
+{
+    if (m_pumpScheduled)
+        return;
+    m_pumpScheduled = true;
+    QMetaObject::invokeMethod(this, &RequestScheduler::pump, Qt::QueuedConnection);
+}
+
+void RequestScheduler::pump()
+{
+    m_pumpScheduled = false;
+    if (!m_pausedUntil.hasExpired())
+        return; // m_timer pumps again when the pause ends
+
+    while (m_running.size() < m_maxInFlight)
+    {
+        auto& queue = !m_queues[int(Lane::Interactive)].isEmpty()
+            ? m_queues[int(Lane::Interactive)]
+            : m_queues[int(Lane::Background)];
+        if (queue.isEmpty())
+            return;
+
+        const Job job = queue.takeFirst();
+        QNetworkReply* reply = job.start();
+        if (!reply)
+            continue;
+
+        m_running.append(Running{reply, job.tag});
+        // Connected after the caller's own handlers, so a handler that queues a follow-up
+        // request (next page) sees it start as soon as this slot is released.
+        connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+            m_running.removeIf([reply](const Running& r) { return !r.reply || r.reply == reply; });
+            schedulePump();
+        });
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QDeadlineTimer>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QTimer>
+
+#include <functional>
+
+class QNetworkReply;
+
+// Caps the number of concurrent Jira requests and orders the backlog by lane:
+// Interactive work (what the user is looking at) always starts before Background work
+// (tray scans, reconciles). A job is a callback that issues one request when a slot frees
+// and returns its reply; the slot is released when that reply finishes. Jobs can be
+// grouped by tag so a whole fan-out can be cancelled once its answer is known.
+class RequestScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    enum class Lane
+    {
+        Interactive,
+        Background
+    };
+
+    // Issues the request and returns its reply, or nullptr to skip the job.
+    using Start = std::function<QNetworkReply*()>;
+
+    explicit RequestScheduler(QObject* parent = nullptr);
+
+    void setMaxInFlight(int maxInFlight);
+    int maxInFlight() const { return m_maxInFlight; }
+
+    // `start` never runs inside enqueue(); queued jobs are started from the event loop,
+    // so a caller may enqueue from within the callback chain of a previous job.
+    void enqueue(Lane lane, Start start, const QString& tag = QString(), std::function<void()> dropped = {});
+    // Like enqueue(), but the job only joins its lane's queue after `delayMs` (retries).
+    void enqueueAfter(int delayMs, Lane lane, Start start, const QString& tag = QString(), std::function<void()> dropped = {});
+
+    // Starts nothing new for `ms` (a server-wide rate limit); running requests go on.
+    void pauseFor(int ms);
+
+    // Drops queued jobs with this tag (their `dropped` callback runs instead of `start`)
+    // and aborts running ones. Delayed jobs count as queued.
+    void cancel(const QString& tag);
+
+    int queued() const { return int(m_queues[0].size() + m_queues[1].size() + m_delayed.size()); }
+    int inFlight() const { return int(m_running.size()); }
+
+private:
+    struct Job
+    {
+        Start start;
+        QString tag;
+        std::function<void()> dropped;
+    };
+
+    struct Running
+    {
+        QPointer<QNetworkReply> reply;
+        QString tag;
+    };
+
+    struct Delayed
+    {
+        Job job;
+        Lane lane;
+        QDeadlineTimer due;
+    };
+
+    void schedulePump();
+    void pump();
+    void releaseDelayed();
+    void armTimer();
+
+    int m_maxInFlight{6};
+    bool m_pumpScheduled{false};
+    QList<Job> m_queues[2]; // indexed by Lane
+    QList<Running> m_running;
+    QList<Delayed> m_delayed;
+    QDeadlineTimer m_pausedUntil;
+    // Fires at the earliest of the next delayed job and the end of a pause.
+    QTimer m_timer;
+};
@@ -0,0 +1,250 @@
+#include "requesttracer.h"
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QNetworkReply>
+#include <QSaveFile>
+#include <QThread>
+
+#include <algorithm>
+#include <bit>
+
+const char* RequestTracer::phaseName(Phase phase)
+{
+    switch (phase)
+    {
+    case Phase::Queue: return "queue";
+    case Phase::Connect: return "connect";
+    case Phase::Tls: return "tls";
+    case Phase::Send: return "send";
+    case Phase::Wait: return "wait";
+    case Phase::Download: return "download";
+    case Phase::Parse: return "parse";
+    case Phase::Apply: return "apply";
+    case Phase::Total: return "total";
+    case Phase::Count: break;
+    }
+    return "?";
+}
+
+void RequestTracer::Histogram::record(qint64 micros)
+{
+    const quint64 v = quint64(std::max<qint64>(1, micros));
+    const int bucket = std::min(kBuckets - 1, int(std::bit_width(v)) - 1);
+    m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(std::max<qint64>(0, micros), std::memory_order_relaxed);
+}
+
+qint64 RequestTracer::Histogram::percentile(double p) const
+{
+    const quint64 total = count();
+    if (total == 0)
+        return 0;
+
+    const quint64 rank = std::max<quint64>(1, quint64(p * double(total) + 0.5));
+    quint64 seen = 0;
+    for (int i = 0; i < kBuckets; ++i)
+    {
+        seen += m_buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank)
+            return (qint64(1) << (i + 1)) - 1;
+    }
+    return (qint64(1) << kBuckets) - 1;
+}
+
+void RequestTracer::Histogram::reset()
+{
+    for (auto& b : m_buckets)
+        b.store(0, std::memory_order_relaxed);
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+}
+
+RequestTracer::RequestTracer()
+{
+    m_epoch.start();
+}
+
+RequestTracer::EndpointStats& RequestTracer::endpoint(const QString& name)
+{
+    QMutexLocker lock(&m_mutex);
+    if (auto* e = m_endpointByName.value(name))
+        return *e;
+    m_endpoints.push_back(std::make_unique<EndpointStats>());
+    m_endpoints.back()->name = name;
+    m_endpointByName.insert(name, m_endpoints.back().get());
+    return *m_endpoints.back();
+}
+
+QList<const RequestTracer::EndpointStats*> RequestTracer::endpoints() const
+{
+    QMutexLocker lock(&m_mutex);
+    QList<const EndpointStats*> out;
+    out.reserve(qsizetype(m_endpoints.size()));
+    for (const auto& e : m_endpoints)
+        out.append(e.get());
+    return out;
+}
+
+void RequestTracer::reset()
+{
+    QMutexLocker lock(&m_mutex);
+    for (auto& e : m_endpoints)
+    {
+        for (auto& h : e->phases)
+            h.reset();
+        e->requests = 0;
+        e->failures = 0;
+        e->bytesIn = 0;
+        e->bytesOut = 0;
+        e->retries = 0;
+        for (auto& s : e->statusClasses)
+            s = 0;
+    }
+    m_events.clear();
+}
+
+void RequestTracer::addEvent(Event event)
+{
+    QMutexLocker lock(&m_mutex);
+    m_events.push_back(std::move(event));
+    if (m_events.size() > kMaxEvents)
+        m_events.pop_front();
+}
+
+void RequestTracer::record(EndpointStats& endpoint, Phase phase, qint64 startMicros, qint64 durationMicros)
+{
+    endpoint.phases[int(phase)].record(durationMicros);
+    addEvent(Event{endpoint.name + " " + phaseName(phase), QStringLiteral("work"), startMicros, durationMicros, 0,
+                   quint64(quintptr(QThread::currentThreadId())), QString()});
+}
+
+void RequestTracer::attach(QNetworkReply* reply, EndpointStats& endpoint, const QString& lane, qint64 enqueued, int attempt)
+{
+    struct Marks
+    {
+        qint64 enqueued{-1};
+        qint64 started{-1};
+        qint64 connecting{-1};
+        qint64 encrypted{-1};
+        qint64 sent{-1};
+        qint64 headers{-1};
+        qint64 bytesIn{0};
+        qint64 bytesOut{0};
+    };
+    auto marks = std::make_shared<Marks>();
+    marks->enqueued = enqueued;
+    marks->started = now();
+
+    // Context is the reply itself, so nothing fires once it has been deleted.
+    QObject::connect(reply, &QNetworkReply::socketStartedConnecting, reply, [this, marks]() {
+        if (marks->connecting < 0) marks->connecting = now();
+    });
+    QObject::connect(reply, &QNetworkReply::encrypted, reply, [this, marks]() { marks->encrypted = now(); });
+    QObject::connect(reply, &QNetworkReply::requestSent, reply, [this, marks]() { marks->sent = now(); });
+    QObject::connect(reply, &QNetworkReply::metaDataChanged, reply, [this, marks]() {
+        if (marks->headers < 0) marks->headers = now();
+    });
+    QObject::connect(reply, &QNetworkReply::uploadProgress, reply, [marks](qint64 sent, qint64) { marks->bytesOut = sent; });
+    QObject::connect(reply, &QNetworkReply::downloadProgress, reply, [marks](qint64 received, qint64) { marks->bytesIn = received; });
+
+    QObject::connect(reply, &QNetworkReply::finished, reply, [this, reply, marks, stats = &endpoint, lane, attempt]() {
+        const qint64 finished = now();
+        const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        const bool failed = reply->error() != QNetworkReply::NoError;
+        const bool fromCache = reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
+
+        auto& s = *stats;
+        s.requests.fetch_add(1, std::memory_order_relaxed);
+        if (failed) s.failures.fetch_add(1, std::memory_order_relaxed);
+        s.bytesIn.fetch_add(quint64(marks->bytesIn), std::memory_order_relaxed);
+        s.bytesOut.fetch_add(quint64(marks->bytesOut), std::memory_order_relaxed);
+        if (attempt > 0) s.retries.fetch_add(1, std::memory_order_relaxed);
+        s.statusClasses[status >= 100 && status < 600 ? status / 100 : 0].fetch_add(1, std::memory_order_relaxed);
+
+        const quint64 id = m_nextRequestId.fetch_add(1, std::memory_order_relaxed);
+        const auto slice = [&](Phase phase, qint64 from, qint64 to) {
+            if (from < 0 || to < from) return;
+            s.phases[int(phase)].record(to - from);
+            addEvent(Event{phaseName(phase), QStringLiteral("http"), from, to - from, id, 0, QString()});
+        };
+
+        // Each phase runs from the latest mark before it, so missing marks (reused
+        // connection, no TLS, cancelled) fold into the neighbouring phase.
+        qint64 at = marks->started;
+        slice(Phase::Queue, marks->enqueued, marks->started);
+        if (marks->connecting >= 0) { slice(Phase::Connect, at, marks->connecting); at = marks->connecting; }
+        if (marks->encrypted >= 0) { slice(Phase::Tls, at, marks->encrypted); at = marks->encrypted; }
+        if (marks->sent >= 0) { slice(Phase::Send, at, marks->sent); at = marks->sent; }
+        if (marks->headers >= 0) { slice(Phase::Wait, at, marks->headers); at = marks->headers; }
+        slice(Phase::Download, at, finished);
+        s.phases[int(Phase::Total)].record(finished - marks->enqueued);
+
+        QJsonObject args;
+        args.insert("url", reply->url().toString(QUrl::RemoveUserInfo));
+        args.insert("lane", lane);
+        args.insert("status", status);
+        args.insert("error", failed ? reply->errorString() : QString());
+        args.insert("fromCache", fromCache);
+        args.insert("bytesIn", marks->bytesIn);
+        args.insert("bytesOut", marks->bytesOut);
+        args.insert("attempt", attempt);
+        addEvent(Event{s.name, QStringLiteral("http"), marks->enqueued, finished - marks->enqueued, id, 0,
+                       QString::fromUtf8(QJsonDocument(args).toJson(QJsonDocument::Compact))});
+    });
+}
+
+bool RequestTracer::exportChromeTrace(const QString& path) const
+{
+    std::deque<Event> events;
+    {
+        QMutexLocker lock(&m_mutex);
+        events = m_events;
+    }
+
+    // Written by hand: a QJsonArray of tens of thousands of objects is needlessly slow.
+    // Requests are async slices (one track each, phases nested inside); parse/apply work
+    // is a complete event on the thread that ran it.
+    QByteArray out;
+    out.reserve(qsizetype(events.size()) * 160);
+    out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    const auto quoted = [](const QString& s) {
+        return QJsonDocument(QJsonObject{{"v", s}}).toJson(QJsonDocument::Compact).mid(5).chopped(1);
+    };
+    const auto append = [&](const QByteArray& e) {
+        if (!first) out += ',';
+        out += e;
+        first = false;
+    };
+
+    for (const auto& e : events)
+    {
+        const QByteArray name = quoted(e.name);
+        const QByteArray cat = quoted(e.category);
+        const QByteArray args = e.args.isEmpty() ? QByteArray("{}") : e.args.toUtf8();
+        if (e.asyncId != 0)
+        {
+            const QByteArray id = QByteArray::number(e.asyncId);
+            append("{\"ph\":\"b\",\"name\":" + name + ",\"cat\":" + cat + ",\"id\":" + id + ",\"pid\":1,\"tid\":1,\"ts\":"
+                   + QByteArray::number(e.start) + ",\"args\":" + args + "}");
+            append("{\"ph\":\"e\",\"name\":" + name + ",\"cat\":" + cat + ",\"id\":" + id + ",\"pid\":1,\"tid\":1,\"ts\":"
+                   + QByteArray::number(e.start + e.duration) + "}");
+        }
+        else
+        {
+            append("{\"ph\":\"X\",\"name\":" + name + ",\"cat\":" + cat + ",\"pid\":1,\"tid\":" + QByteArray::number(e.threadId)
+                   + ",\"ts\":" + QByteArray::number(e.start) + ",\"dur\":" + QByteArray::number(e.duration) + ",\"args\":" + args + "}");
+        }
+    }
+    out += "]}";
+
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly))
+        return false;
+    f.write(out);
+    return f.commit();
+}
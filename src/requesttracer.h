@@ -0,0 +1,120 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+
+class QNetworkReply;
+
+// Per-endpoint timing, size and status statistics for JiraClient requests, plus a ring
+// buffer of recent requests that can be exported as Chrome trace JSON (chrome://tracing,
+// ui.perfetto.dev). Callers resolve an endpoint's EndpointStats once (per request or per
+// call site) and record against it; counters and histograms are atomics, so recording
+// and the debug dock reading them never block each other. Only resolving a name and
+// appending to the trace ring buffer take a short mutex.
+class RequestTracer
+{
+public:
+    // Request phases follow QNetworkReply's signals. Connect covers DNS and TCP and Tls the
+    // handshake; both are absent when a pooled connection is reused. Wait is time to first
+    // byte after the request was sent; Apply is the UI/model update after a result lands.
+    enum class Phase
+    {
+        Queue,
+        Connect,
+        Tls,
+        Send,
+        Wait,
+        Download,
+        Parse,
+        Apply,
+        Total,
+        Count
+    };
+    static const char* phaseName(Phase phase);
+
+    // Log2 buckets over microseconds: bucket i counts samples in [2^i, 2^(i+1)).
+    class Histogram
+    {
+    public:
+        static constexpr int kBuckets = 32;
+
+        void record(qint64 micros);
+        quint64 count() const { return m_count.load(std::memory_order_relaxed); }
+        qint64 sumMicros() const { return m_sum.load(std::memory_order_relaxed); }
+        // Upper bound of the bucket holding the p-th percentile (0..1); 0 when empty.
+        qint64 percentile(double p) const;
+        void reset();
+
+    private:
+        std::array<std::atomic<quint64>, kBuckets> m_buckets{};
+        std::atomic<quint64> m_count{0};
+        std::atomic<qint64> m_sum{0};
+    };
+
+    struct EndpointStats
+    {
+        QString name;
+        std::array<Histogram, int(Phase::Count)> phases;
+        std::atomic<quint64> requests{0};
+        std::atomic<quint64> failures{0};
+        std::atomic<quint64> bytesIn{0};
+        std::atomic<quint64> bytesOut{0};
+        std::atomic<quint64> retries{0};
+        // [0] = no HTTP status (network error), [1..5] = 1xx..5xx
+        std::array<std::atomic<quint64>, 6> statusClasses{};
+    };
+
+    RequestTracer();
+
+    // Microseconds since the tracer was created; safe from any thread.
+    qint64 now() const { return m_epoch.nsecsElapsed() / 1000; }
+
+    // The statistics for `name`, created on first use. Takes the registry lock; keep the
+    // reference rather than resolving per sample. Valid for the tracer's lifetime.
+    EndpointStats& endpoint(const QString& name);
+
+    // Follows `reply` through its phases and records it under `endpoint` when it finishes.
+    // `enqueued` is when the request was queued (now() at the time); `attempt` is 0 unless
+    // this is a retry.
+    void attach(QNetworkReply* reply, EndpointStats& endpoint, const QString& lane, qint64 enqueued, int attempt = 0);
+
+    // A phase measured outside a reply (parse on a worker thread, model updates).
+    void record(EndpointStats& endpoint, Phase phase, qint64 startMicros, qint64 durationMicros);
+
+    // Stable for the tracer's lifetime; entries are never removed, only reset.
+    QList<const EndpointStats*> endpoints() const;
+    void reset();
+
+    bool exportChromeTrace(const QString& path) const;
+
+private:
+    struct Event
+    {
+        QString name;
+        QString category;
+        qint64 start{0};
+        qint64 duration{0};
+        quint64 asyncId{0}; // non-zero: async slice nested under request `asyncId`
+        quint64 threadId{0};
+        QString args; // preformatted JSON object, may be empty
+    };
+
+    void addEvent(Event event);
+
+    QElapsedTimer m_epoch;
+    std::atomic<quint64> m_nextRequestId{1};
+
+    mutable QMutex m_mutex;
+    std::deque<std::unique_ptr<EndpointStats>> m_endpoints;
+    QHash<QString, EndpointStats*> m_endpointByName;
+    std::deque<Event> m_events;
+    static constexpr size_t kMaxEvents = 20000;
+};
@@ -0,0 +1,132 @@
+#include "retrypolicy.h"
+
+#include <QDateTime>
+#include <QLocale>
+#include <QNetworkReply>
+#include <QTimeZone>
+
+#include <algorithm>
+
+namespace
+{
+// Up to 10 retries in a burst, then one for every five first attempts.
+constexpr double kBudgetMax = 10.0;
+constexpr double kBudgetPerRequest = 0.2;
+
+// Interactive requests have someone waiting on them: fewer, shorter tries.
+constexpr int kMaxAttemptsInteractive = 3;
+constexpr int kMaxAttemptsBackground = 5;
+constexpr int kBaseDelayInteractiveMs = 500;
+constexpr int kBaseDelayBackgroundMs = 2000;
+constexpr int kMaxDelayInteractiveMs = 8000;
+constexpr int kMaxDelayBackgroundMs = 60000;
+// A longer Retry-After than this fails the request instead of parking it.
+constexpr int kMaxRetryAfterInteractiveMs = 30000;
+constexpr int kMaxRetryAfterBackgroundMs = 300000;
+
+bool isTransientNetworkError(QNetworkReply::NetworkError err)
+{
+    switch (err)
+    {
+    case QNetworkReply::ConnectionRefusedError:
+    case QNetworkReply::RemoteHostClosedError:
+    case QNetworkReply::TimeoutError:
+    case QNetworkReply::TemporaryNetworkFailureError:
+    case QNetworkReply::NetworkSessionFailedError:
+    case QNetworkReply::ProxyConnectionClosedError:
+    case QNetworkReply::ProxyTimeoutError:
+    case QNetworkReply::UnknownNetworkError:
+        return true;
+    default:
+        return false;
+    }
+}
+}
+
+void RetryPolicy::markIdempotent(QNetworkRequest& request)
+{
+    request.setAttribute(kIdempotentAttribute, true);
+}
+
+void RetryPolicy::recordRequest()
+{
+    m_budget = std::min(kBudgetMax, m_budget + kBudgetPerRequest);
+}
+
+RetryPolicy::Decision RetryPolicy::evaluate(const QNetworkReply* reply, int attempt, bool interactive)
+{
+    const auto err = reply->error();
+    // OperationCanceledError is our own abort(): the request is no longer wanted.
+    if (err == QNetworkReply::NoError || err == QNetworkReply::OperationCanceledError)
+        return {};
+
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    const bool rateLimited = status == 429;
+    const bool transient = rateLimited || status == 502 || status == 503 || status == 504
+        || (status == 0 && isTransientNetworkError(err));
+    if (!transient)
+        return {};
+    if (!rateLimited && !isIdempotent(reply))
+        return {};
+    if (attempt + 1 >= (interactive ? kMaxAttemptsInteractive : kMaxAttemptsBackground))
+        return {};
+
+    int delayMs = backoffMs(attempt, interactive);
+    const int retryAfter = retryAfterMs(reply);
+    if (retryAfter >= 0)
+    {
+        if (retryAfter > (interactive ? kMaxRetryAfterInteractiveMs : kMaxRetryAfterBackgroundMs))
+            return {};
+        // Spread the clients that were told the same moment.
+        delayMs = retryAfter + int(m_random.bounded(retryAfter / 10 + 250));
+    }
+
+    if (m_budget < 1.0)
+        return {};
+    m_budget -= 1.0;
+
+    return Decision{true, delayMs, rateLimited};
+}
+
+bool RetryPolicy::isIdempotent(const QNetworkReply* reply)
+{
+    switch (reply->operation())
+    {
+    case QNetworkAccessManager::GetOperation:
+    case QNetworkAccessManager::HeadOperation:
+    case QNetworkAccessManager::PutOperation:
+    case QNetworkAccessManager::DeleteOperation:
+        return true;
+    default:
+        return reply->request().attribute(kIdempotentAttribute).toBool();
+    }
+}
+
+int RetryPolicy::retryAfterMs(const QNetworkReply* reply)
+{
+    const QByteArray value = reply->rawHeader("Retry-After").trimmed();
+    if (value.isEmpty())
+        return -1;
+
+    bool ok = false;
+    const qint64 seconds = value.toLongLong(&ok);
+    if (ok)
+        return seconds < 0 ? -1 : int(std::min<qint64>(seconds, 24 * 3600) * 1000);
+
+    // HTTP-date, e.g. "Wed, 21 Oct 2015 07:28:00 GMT".
+    const QDateTime parsed = QLocale::c().toDateTime(QString::fromLatin1(value), QStringLiteral("ddd, dd MMM yyyy HH:mm:ss 'GMT'"));
+    if (!parsed.isValid())
+        return -1;
+    const QDateTime at(parsed.date(), parsed.time(), QTimeZone::UTC);
+    const qint64 ms = QDateTime::currentDateTimeUtc().msecsTo(at);
+    return int(std::clamp<qint64>(ms, 0, 24 * 3600 * 1000));
+}
+
+int RetryPolicy::backoffMs(int attempt, bool interactive)
+{
+    const int base = interactive ? kBaseDelayInteractiveMs : kBaseDelayBackgroundMs;
+    const int cap = interactive ? kMaxDelayInteractiveMs : kMaxDelayBackgroundMs;
+    const int ceiling = int(std::min<qint64>(cap, qint64(base) << std::min(attempt, 16)));
+    // "Equal jitter": at least half the exponential step, so retries still back off.
+    return ceiling / 2 + int(m_random.bounded(ceiling / 2 + 1));
+}
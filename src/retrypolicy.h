@@ -0,0 +1,47 @@
+#pragma once
+
+#include <QNetworkRequest>
+#include <QRandomGenerator>
+
+class QNetworkReply;
+
+// Decides whether a failed reply is worth another attempt and how long to wait first.
+//
+// Rate limits (429) are retried for every method: Jira rejected the request before doing
+// anything with it. Gateway errors (502/503/504) and dropped connections are only retried
+// for idempotent requests (GET, PUT, DELETE, and POSTs marked with markIdempotent()), since
+// a POST that failed mid-flight may already have been applied.
+//
+// The delay is the server's Retry-After if it sent one, otherwise exponential backoff with
+// jitter. Retries draw from a budget refilled by first attempts, so a burst of failures
+// stops retrying instead of multiplying the load on a struggling server.
+class RetryPolicy
+{
+public:
+    struct Decision
+    {
+        bool retry{false};
+        int delayMs{0};
+        bool rateLimited{false}; // the server asked every client request to slow down
+    };
+
+    // For POSTs that only read (searches); the request is safe to send twice.
+    static void markIdempotent(QNetworkRequest& request);
+
+    // Call once per first attempt; it refills the retry budget.
+    void recordRequest();
+
+    // `attempt` is 0 for the first try. Withdraws from the budget when it says retry.
+    Decision evaluate(const QNetworkReply* reply, int attempt, bool interactive);
+
+private:
+    static constexpr auto kIdempotentAttribute = QNetworkRequest::Attribute(QNetworkRequest::User + 1);
+
+    static bool isIdempotent(const QNetworkReply* reply);
+    // -1 if the reply has no usable Retry-After header.
+    static int retryAfterMs(const QNetworkReply* reply);
+    int backoffMs(int attempt, bool interactive);
+
+    double m_budget{10.0};
+    QRandomGenerator m_random{QRandomGenerator::securelySeeded()};
+};
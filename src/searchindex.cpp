@@ -0,0 +1,371 @@
+#include "searchindex.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+static constexpr quint32 kMagic = 0x4A585349; // "JXSI"
+static constexpr quint16 kVersion = 2;
+
+// Field weights: a hit in the key/summary outranks one buried in a comment thread.
+static constexpr float kSummaryWeight = 3.0f;
+static constexpr float kDescriptionWeight = 1.0f;
+static constexpr float kCommentWeight = 0.5f;
+
+// Shorter tokens only match exactly, otherwise "a" would expand to half the vocabulary.
+static constexpr int kMinPrefixLength = 2;
+static constexpr int kMaxTokenLength = 64;
+
+QStringList SearchIndex::tokenize(const QString& text)
+{
+    QStringList tokens;
+    QString current;
+    const auto flush = [&]() {
+        // Single letters carry no signal; single digits do ("PROJ-7").
+        if (current.size() >= 2 || (current.size() == 1 && current.at(0).isDigit()))
+            tokens.append(current.left(kMaxTokenLength));
+        current.clear();
+    };
+
+    for (const QChar c : text)
+    {
+        if (c.isLetterOrNumber())
+            current.append(c.toLower());
+        else
+            flush();
+    }
+    flush();
+    return tokens;
+}
+
+void SearchIndex::setDocument(const QString& key,
+                              const QString& summary,
+                              const QString& description,
+                              const QStringList& comments)
+{
+    if (key.isEmpty())
+        return;
+
+    size_t hash = qHashMulti(0, summary, description);
+    for (const auto& c : comments)
+        hash = qHashMulti(hash, c);
+
+    const auto existing = m_docByKey.constFind(key);
+    if (existing != m_docByKey.constEnd())
+    {
+        if (m_docs[*existing].contentHash == hash)
+            return;
+        removeDocument(key);
+    }
+
+    QHash<qint32, float> weights;
+    // The key is indexed by its parts ("proj", "123"), as tokenize() splits queries.
+    addTerms(weights, key, kSummaryWeight);
+    addTerms(weights, summary, kSummaryWeight);
+    addTerms(weights, description, kDescriptionWeight);
+    for (const auto& c : comments)
+        addTerms(weights, c, kCommentWeight);
+
+    const qint32 doc = qint32(m_docs.size());
+    m_docs.append(Doc{key, hash, true});
+    m_docByKey.insert(key, doc);
+
+    for (auto it = weights.cbegin(); it != weights.cend(); ++it)
+    {
+        // Dampen repetition: the tenth mention is worth far less than the first.
+        const float w = 1.0f + std::log(it.value());
+        m_postings[it.key()].append(Posting{doc, w});
+    }
+}
+
+void SearchIndex::removeDocument(const QString& key)
+{
+    const auto it = m_docByKey.find(key);
+    if (it == m_docByKey.end())
+        return;
+
+    m_docs[*it].alive = false;
+    m_docByKey.erase(it);
+    ++m_deadDocs;
+
+    if (m_deadDocs > 1024 && m_deadDocs > m_docByKey.size())
+        compact();
+}
+
+void SearchIndex::clear()
+{
+    m_docs.clear();
+    m_docByKey.clear();
+    m_termIds.clear();
+    m_postings.clear();
+    m_deadDocs = 0;
+}
+
+QList<SearchIndex::Hit> SearchIndex::search(const QString& query, int limit) const
+{
+    const auto total = score(query);
+
+    QList<Hit> hits;
+    hits.reserve(total.size());
+    for (auto it = total.cbegin(); it != total.cend(); ++it)
+        hits.append(Hit{m_docs[it.key()].key, it.value()});
+
+    const auto byScore = [](const Hit& a, const Hit& b) {
+        if (a.score != b.score) return a.score > b.score;
+        return a.key < b.key;
+    };
+    if (limit > 0 && hits.size() > limit)
+    {
+        std::partial_sort(hits.begin(), hits.begin() + limit, hits.end(), byScore);
+        hits.resize(limit);
+    }
+    else
+    {
+        std::sort(hits.begin(), hits.end(), byScore);
+    }
+    return hits;
+}
+
+QSet<QString> SearchIndex::matches(const QString& query) const
+{
+    const auto total = score(query);
+    QSet<QString> keys;
+    keys.reserve(total.size());
+    for (auto it = total.cbegin(); it != total.cend(); ++it)
+        keys.insert(m_docs[it.key()].key);
+    return keys;
+}
+
+QHash<qint32, float> SearchIndex::score(const QString& query) const
+{
+    const auto tokens = tokenize(query);
+    if (tokens.isEmpty() || m_docByKey.isEmpty())
+        return {};
+
+    const float docCount = float(m_docByKey.size());
+
+    // Score per doc for the current token, then intersect with the running total.
+    QHash<qint32, float> total;
+    bool first = true;
+    for (const auto& token : tokens)
+    {
+        QHash<qint32, float> scores;
+        const auto addTerm = [&](qint32 term, float boost) {
+            const auto& postings = m_postings[term];
+            const float idf = std::log(1.0f + docCount / float(std::max<qsizetype>(1, postings.size())));
+            for (const auto& p : postings)
+            {
+                if (!m_docs[p.doc].alive) continue;
+                auto& s = scores[p.doc];
+                s = std::max(s, p.weight * idf * boost);
+            }
+        };
+
+        if (token.size() < kMinPrefixLength)
+        {
+            const auto it = m_termIds.constFind(token);
+            if (it != m_termIds.constEnd())
+                addTerm(*it, 1.0f);
+        }
+        else
+        {
+            for (auto it = m_termIds.lowerBound(token); it != m_termIds.constEnd() && it.key().startsWith(token); ++it)
+                addTerm(*it, it.key().size() == token.size() ? 1.5f : 1.0f);
+        }
+
+        if (first)
+        {
+            total = std::move(scores);
+            first = false;
+        }
+        else
+        {
+            for (auto it = total.begin(); it != total.end();)
+            {
+                const auto s = scores.constFind(it.key());
+                if (s == scores.constEnd())
+                {
+                    it = total.erase(it);
+                    continue;
+                }
+                it.value() += *s;
+                ++it;
+            }
+        }
+
+        if (total.isEmpty())
+            return {};
+    }
+    return total;
+}
+
+qint32 SearchIndex::termId(const QString& term)
+{
+    const auto it = m_termIds.constFind(term);
+    if (it != m_termIds.constEnd())
+        return *it;
+    const qint32 id = qint32(m_postings.size());
+    m_termIds.insert(term, id);
+    m_postings.append(QVector<Posting>());
+    return id;
+}
+
+void SearchIndex::addTerms(QHash<qint32, float>& weights, const QString& text, float fieldWeight)
+{
+    for (const auto& token : tokenize(text))
+        weights[termId(token)] += fieldWeight;
+}
+
+void SearchIndex::compact()
+{
+    QVector<qint32> remap(m_docs.size(), -1);
+    QVector<Doc> docs;
+    docs.reserve(m_docByKey.size());
+    for (qint32 i = 0; i < m_docs.size(); ++i)
+    {
+        if (!m_docs[i].alive) continue;
+        remap[i] = qint32(docs.size());
+        docs.append(m_docs[i]);
+    }
+
+    // Terms left without live documents are dropped and the rest renumbered, so the
+    // vocabulary does not outgrow the tickets it describes.
+    QMap<QString, qint32> termIds;
+    QVector<QVector<Posting>> postings;
+    postings.reserve(m_postings.size());
+    for (auto it = m_termIds.cbegin(); it != m_termIds.cend(); ++it)
+    {
+        QVector<Posting> kept;
+        kept.reserve(m_postings[*it].size());
+        for (const auto& p : m_postings[*it])
+            if (remap[p.doc] >= 0)
+                kept.append(Posting{remap[p.doc], p.weight});
+        if (kept.isEmpty())
+            continue;
+        termIds.insert(it.key(), qint32(postings.size()));
+        postings.append(std::move(kept));
+    }
+    m_termIds = std::move(termIds);
+    m_postings = std::move(postings);
+
+    m_docs = std::move(docs);
+    m_docByKey.clear();
+    for (qint32 i = 0; i < m_docs.size(); ++i)
+        m_docByKey.insert(m_docs[i].key, i);
+    m_deadDocs = 0;
+}
+
+bool SearchIndex::load(const QString& identity, const QString& path)
+{
+    QFile f(path);
+    if (!f.exists() || !f.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&f);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    QString storedIdentity;
+    in >> magic >> version;
+    if (magic != kMagic || version != kVersion)
+        return false;
+    in >> storedIdentity;
+    if (storedIdentity != identity)
+        return false;
+
+    SearchIndex loaded;
+    // Counts come from disk; never size anything past what the file could hold. A
+    // rejected file leaves the index empty and the caller's reindex rebuilds it.
+    const auto bytesLeft = [&f] { return quint64(std::max<qint64>(0, f.size() - f.pos())); };
+
+    quint32 docCount = 0;
+    in >> docCount;
+    if (docCount > quint32(std::numeric_limits<qint32>::max()))
+        return false;
+    loaded.m_docs.reserve(qsizetype(std::min<quint64>(docCount, bytesLeft())));
+    for (quint32 i = 0; i < docCount && in.status() == QDataStream::Ok; ++i)
+    {
+        Doc d;
+        quint64 hash = 0;
+        in >> d.key >> hash;
+        d.contentHash = size_t(hash);
+        loaded.m_docByKey.insert(d.key, qint32(i));
+        loaded.m_docs.append(d);
+    }
+
+    quint32 termCount = 0;
+    in >> termCount;
+    // Each term is at least a string length and a posting count.
+    if (in.status() != QDataStream::Ok || termCount > bytesLeft() / (2 * sizeof(quint32)))
+        return false;
+    loaded.m_postings.resize(termCount);
+    for (quint32 t = 0; t < termCount && in.status() == QDataStream::Ok; ++t)
+    {
+        QString term;
+        quint32 n = 0;
+        in >> term >> n;
+        if (in.status() != QDataStream::Ok || n > bytesLeft() / sizeof(Posting))
+            return false;
+        loaded.m_termIds.insert(term, qint32(t));
+        // Postings are plain structs written as one raw block per term.
+        auto& postings = loaded.m_postings[t];
+        postings.resize(n);
+        const auto bytes = qint64(n) * qint64(sizeof(Posting));
+        if (in.readRawData(reinterpret_cast<char*>(postings.data()), bytes) != bytes)
+            return false;
+        for (const auto& p : postings)
+        {
+            if (p.doc < 0 || quint32(p.doc) >= docCount)
+                return false;
+        }
+    }
+
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    *this = std::move(loaded);
+    return true;
+}
+
+bool SearchIndex::save(const QString& identity, const QString& path)
+{
+    if (m_deadDocs > 0)
+        compact();
+
+    QSaveFile out(path);
+    if (!out.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream s(&out);
+    s.setVersion(QDataStream::Qt_6_0);
+    s << kMagic << kVersion << identity;
+
+    s << quint32(m_docs.size());
+    for (const auto& d : m_docs)
+        s << d.key << quint64(d.contentHash);
+
+    // Terms in id order so postings can be read straight back into place.
+    QVector<QString> terms(m_postings.size());
+    for (auto it = m_termIds.cbegin(); it != m_termIds.cend(); ++it)
+        terms[*it] = it.key();
+
+    s << quint32(m_postings.size());
+    for (qsizetype t = 0; t < m_postings.size(); ++t)
+    {
+        const auto& postings = m_postings[t];
+        s << terms[t] << quint32(postings.size());
+        s.writeRawData(reinterpret_cast<const char*>(postings.constData()), int(postings.size() * sizeof(Posting)));
+    }
+
+    if (s.status() != QDataStream::Ok)
+    {
+        out.cancelWriting();
+        return false;
+    }
+    return out.commit();
+}
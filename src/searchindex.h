@@ -0,0 +1,72 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// In-process inverted index over ticket text (key + summary, description, comments).
+// Terms are kept sorted so a query token matches every indexed term it prefixes; results
+// are ranked by field weight and term rarity. Updating a document retires its old id and
+// appends a new one, and dead postings are compacted away in bulk, so incremental
+// updates never rewrite posting lists.
+class SearchIndex
+{
+public:
+    struct Hit
+    {
+        QString key;
+        float score{0};
+    };
+
+    // Re-indexes `key` unless its content is unchanged since the last call.
+    void setDocument(const QString& key,
+                     const QString& summary,
+                     const QString& description,
+                     const QStringList& comments);
+    void removeDocument(const QString& key);
+    void clear();
+
+    QStringList keys() const { return m_docByKey.keys(); }
+    int documentCount() const { return int(m_docByKey.size()); }
+
+    // All query tokens must match (as exact term or prefix); best hits first.
+    QList<Hit> search(const QString& query, int limit = 50) const;
+    // Keys of every hit for the same query, unranked.
+    QSet<QString> matches(const QString& query) const;
+
+    static QStringList tokenize(const QString& text);
+
+    // Persisted next to the ticket cache; `identity` must match for load() to succeed.
+    bool load(const QString& identity, const QString& path = QStringLiteral("searchindex.bin"));
+    bool save(const QString& identity, const QString& path = QStringLiteral("searchindex.bin"));
+
+private:
+    struct Posting
+    {
+        qint32 doc;
+        float weight;
+    };
+
+    struct Doc
+    {
+        QString key;
+        size_t contentHash{0};
+        bool alive{true};
+    };
+
+    // Summed score per live doc id matching every query token.
+    QHash<qint32, float> score(const QString& query) const;
+    qint32 termId(const QString& term);
+    void addTerms(QHash<qint32, float>& weights, const QString& text, float fieldWeight);
+    void compact();
+
+    QVector<Doc> m_docs;
+    QHash<QString, qint32> m_docByKey;
+    QMap<QString, qint32> m_termIds; // sorted, for prefix scans
+    QVector<QVector<Posting>> m_postings; // by term id
+    qint32 m_deadDocs{0};
+};
@@ -18,6 +18,7 @@ SettingsDialog::~SettingsDialog()
 
 void SettingsDialog::setConfig(const AppConfig& cfg)
 {
+    m_cfg = cfg;
     ui->lineInstanceUrl->setText(cfg.jira.instanceUrl);
     ui->lineUsername->setText(cfg.jira.username);
     ui->lineApiToken->setText(cfg.jira.apiToken);
@@ -25,7 +26,7 @@ void SettingsDialog::setConfig(const AppConfig& cfg)
 
 AppConfig SettingsDialog::config() const
 {
-    AppConfig cfg;
+    AppConfig cfg = m_cfg;
     cfg.jira.instanceUrl = ui->lineInstanceUrl->text().trimmed();
     cfg.jira.username = ui->lineUsername->text().trimmed();
     cfg.jira.apiToken = ui->lineApiToken->text();
@@ -20,4 +20,6 @@ public:
 
 private:
     Ui::SettingsDialog* ui;
+    // Settings without an editor here are passed through unchanged.
+    AppConfig m_cfg;
 };
@@ -0,0 +1,134 @@
+#include "ticketcache.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+
+// Bump kVersion whenever a struct layout below changes; older files are then ignored.
+static constexpr quint32 kMagic = 0x4A585443; // "JXTC"
+static constexpr quint16 kVersion = 2;
+
+template <typename T>
+static void writeOptional(QDataStream& s, const std::optional<T>& v)
+{
+    s << v.has_value();
+    if (v.has_value()) s << *v;
+}
+
+template <typename T>
+static void readOptional(QDataStream& s, std::optional<T>& v)
+{
+    bool has = false;
+    s >> has;
+    v.reset();
+    if (has)
+    {
+        T value{};
+        s >> value;
+        v = value;
+    }
+}
+
+static QDataStream& operator<<(QDataStream& s, const JiraTicket& t)
+{
+    return s << t.key << t.summary << t.status << t.sprint << t.updated;
+}
+
+static QDataStream& operator>>(QDataStream& s, JiraTicket& t)
+{
+    return s >> t.key >> t.summary >> t.status >> t.sprint >> t.updated;
+}
+
+static QDataStream& operator<<(QDataStream& s, const JiraComment& c)
+{
+    return s << c.id << c.author << c.created << c.editableBody;
+}
+
+static QDataStream& operator>>(QDataStream& s, JiraComment& c)
+{
+    return s >> c.id >> c.author >> c.created >> c.editableBody;
+}
+
+static QDataStream& operator<<(QDataStream& s, const JiraHistoryEntry& h)
+{
+    return s << h.author << h.when << h.field << h.fromValue << h.toValue;
+}
+
+static QDataStream& operator>>(QDataStream& s, JiraHistoryEntry& h)
+{
+    return s >> h.author >> h.when >> h.field >> h.fromValue >> h.toValue;
+}
+
+static QDataStream& operator<<(QDataStream& s, const JiraIssueFieldSnapshot& f)
+{
+    s << f.description << f.descriptionAdf;
+    writeOptional(s, f.storyPoints);
+    s << f.assigneeDisplayName << f.assigneeAccountId << f.sprintName;
+    writeOptional(s, f.sprintId);
+    writeOptional(s, f.dueDate);
+    return s;
+}
+
+static QDataStream& operator>>(QDataStream& s, JiraIssueFieldSnapshot& f)
+{
+    s >> f.description >> f.descriptionAdf;
+    readOptional(s, f.storyPoints);
+    s >> f.assigneeDisplayName >> f.assigneeAccountId >> f.sprintName;
+    readOptional(s, f.sprintId);
+    readOptional(s, f.dueDate);
+    return s;
+}
+
+static QDataStream& operator<<(QDataStream& s, const JiraIssueDetails& d)
+{
+    return s << d.key << d.fields << d.comments << d.history;
+}
+
+static QDataStream& operator>>(QDataStream& s, JiraIssueDetails& d)
+{
+    s >> d.key >> d.fields >> d.comments >> d.history;
+    d.valid = true;
+    return s;
+}
+
+bool TicketCache::load(TicketCacheData& out, const QString& path)
+{
+    QFile f(path);
+    if (!f.exists() || !f.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&f);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    in >> magic >> version;
+    if (magic != kMagic || version != kVersion)
+        return false;
+
+    TicketCacheData data;
+    in >> data.identity >> data.watermark >> data.tickets >> data.details;
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    out = std::move(data);
+    return true;
+}
+
+bool TicketCache::save(const TicketCacheData& data, const QString& path)
+{
+    QSaveFile out(path);
+    if (!out.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream s(&out);
+    s.setVersion(QDataStream::Qt_6_0);
+    s << kMagic << kVersion;
+    s << data.identity << data.watermark << data.tickets << data.details;
+    if (s.status() != QDataStream::Ok)
+    {
+        out.cancelWriting();
+        return false;
+    }
+    return out.commit();
+}
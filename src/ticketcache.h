@@ -0,0 +1,26 @@
+#pragma once
+
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QString>
+
+#include "models.h"
+
+struct TicketCacheData
+{
+    // Instance URL + user the data was fetched for; a mismatch means the cache is not ours.
+    QString identity;
+    QDateTime watermark;
+    QList<JiraTicket> tickets;
+    QHash<QString, JiraIssueDetails> details;
+};
+
+// Last known tickets and issue details, persisted in a compact QDataStream format next
+// to appsettings.json so the tree can be painted before the first network round trip.
+class TicketCache
+{
+public:
+    static bool load(TicketCacheData& out, const QString& path = QStringLiteral("ticketcache.bin"));
+    static bool save(const TicketCacheData& data, const QString& path = QStringLiteral("ticketcache.bin"));
+};
@@ -0,0 +1,87 @@
+#include "ticketsfilterproxy.h"
+
+#include "ticketsmodel.h"
+
+TicketsFilterProxyModel::TicketsFilterProxyModel(TicketsModel* source, QObject* parent)
+    : QSortFilterProxyModel(parent), m_source(source)
+{
+    // A group stays visible while any of its tickets matches.
+    setRecursiveFilteringEnabled(true);
+    setSourceModel(m_source);
+}
+
+void TicketsFilterProxyModel::setStatusFilter(const QSet<QString>& statuses)
+{
+    if (statuses == m_statuses)
+        return;
+    m_statuses = statuses;
+    m_statusMask = maskFor(statuses);
+    invalidateRowsFilter();
+}
+
+void TicketsFilterProxyModel::setSprintFilter(const QSet<QString>& sprints)
+{
+    if (sprints == m_sprints)
+        return;
+    m_sprints = sprints;
+    m_sprintMask = maskFor(sprints);
+    invalidateRowsFilter();
+}
+
+void TicketsFilterProxyModel::setKeyFilter(const std::optional<QSet<QString>>& keys)
+{
+    if (keys == m_keys)
+        return;
+    m_keys = keys;
+    invalidateRowsFilter();
+}
+
+bool TicketsFilterProxyModel::isFiltering() const
+{
+    return !m_statuses.isEmpty() || !m_sprints.isEmpty() || m_keys.has_value();
+}
+
+QBitArray TicketsFilterProxyModel::maskFor(const QSet<QString>& names)
+{
+    // Names that no ticket has yet get an id now; a ticket that shows up with one later
+    // gets the same id.
+    QBitArray mask;
+    for (const auto& name : names)
+    {
+        const qsizetype id = InternedString(name).id();
+        if (id >= mask.size()) mask.resize(id + 1);
+        mask.setBit(id);
+    }
+    return mask;
+}
+
+bool TicketsFilterProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const
+{
+    // Group rows: let recursive filtering decide from their tickets.
+    if (!sourceParent.isValid())
+        return !isFiltering();
+
+    if (!m_sprints.isEmpty())
+    {
+        const qsizetype id = m_source->groupName(sourceParent.row()).id();
+        if (id >= m_sprintMask.size() || !m_sprintMask.testBit(id))
+            return false;
+    }
+
+    const auto idx = m_source->index(sourceRow, 0, sourceParent);
+    const auto* t = m_source->ticketForIndex(idx);
+    if (!t)
+        return false;
+
+    if (!m_statuses.isEmpty())
+    {
+        const qsizetype id = t->status.id();
+        if (id >= m_statusMask.size() || !m_statusMask.testBit(id))
+            return false;
+    }
+
+    if (m_keys && !m_keys->contains(t->key))
+        return false;
+
+    return true;
+}
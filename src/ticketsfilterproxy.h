@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QBitArray>
+#include <QSet>
+#include <QSortFilterProxyModel>
+
+#include <optional>
+
+class TicketsModel;
+
+// Filters the ticket tree without touching the source model, so switching filters keeps
+// selection and expansion. Status and sprint matching are bit tests on the interned ids of
+// the names; sprint matching is decided per group. Empty filters match everything.
+class TicketsFilterProxyModel : public QSortFilterProxyModel
+{
+    Q_OBJECT
+public:
+    explicit TicketsFilterProxyModel(TicketsModel* source, QObject* parent = nullptr);
+
+    void setStatusFilter(const QSet<QString>& statuses);
+    void setSprintFilter(const QSet<QString>& sprints);
+    // Restrict to these ticket keys (search index results); nullopt disables the filter.
+    void setKeyFilter(const std::optional<QSet<QString>>& keys);
+
+    bool isFiltering() const;
+
+protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const override;
+
+private:
+    static QBitArray maskFor(const QSet<QString>& names);
+
+    TicketsModel* m_source;
+    QSet<QString> m_statuses;
+    QSet<QString> m_sprints;
+    std::optional<QSet<QString>> m_keys;
+    QBitArray m_statusMask;
+    QBitArray m_sprintMask;
+};
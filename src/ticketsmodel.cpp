@@ -1,52 +1,536 @@
 #include "ticketsmodel.h"
 
-#include <QMap>
+#include <QSet>
+
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+// Pages fetched while tickets change can repeat a key; the first copy is the newest.
+QList<JiraTicket> withoutDuplicates(const QList<JiraTicket>& tickets)
+{
+    QSet<QString> seen;
+    seen.reserve(tickets.size());
+    qsizetype first = 0;
+    while (first < tickets.size() && !seen.contains(tickets[first].key))
+        seen.insert(tickets[first++].key);
+    if (first == tickets.size())
+        return tickets;
+
+    QList<JiraTicket> unique(tickets.cbegin(), tickets.cbegin() + first);
+    for (qsizetype i = first + 1; i < tickets.size(); ++i)
+    {
+        if (seen.contains(tickets[i].key))
+            continue;
+        seen.insert(tickets[i].key);
+        unique.append(tickets[i]);
+    }
+    return unique;
+}
+
+// Single-row moves step 6 of applyDiff needs to turn `current` into `target` (the same
+// keys): each target key is either next in line among the keys not moved yet, or moved.
+qsizetype reorderMoves(const QStringList& current, const QStringList& target)
+{
+    QSet<QString> moved;
+    qsizetype next = 0;
+    qsizetype moves = 0;
+    for (const auto& key : target)
+    {
+        while (next < current.size() && moved.contains(current[next]))
+            ++next;
+        if (next < current.size() && current[next] == key)
+        {
+            ++next;
+            continue;
+        }
+        moved.insert(key);
+        ++moves;
+    }
+    return moves;
+}
+} // namespace
 
 TicketsModel::TicketsModel(QObject* parent)
-    : QStandardItemModel(parent)
+    : QAbstractItemModel(parent)
 {
-    setHorizontalHeaderLabels({"Tickets"});
+}
+
+InternedString TicketsModel::groupNameFor(const JiraTicket& t)
+{
+    static const InternedString noSprint(QStringLiteral("No Sprint"));
+    return t.sprint.isEmpty() ? noSprint : t.sprint;
 }
 
 void TicketsModel::setTickets(const QList<JiraTicket>& tickets)
 {
-    clear();
-    setHorizontalHeaderLabels({"Tickets"});
+    const auto unique = withoutDuplicates(tickets);
+    if (m_groups.isEmpty() || !applyDiff(unique))
+        resetTo(unique);
+}
+
+void TicketsModel::resetTo(const QList<JiraTicket>& tickets)
+{
+    beginResetModel();
+
+    // Group by sprint name (alphabetical groups, original order within a group).
+    QVector<int> order(tickets.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&tickets](int a, int b) {
+        const auto ga = groupNameFor(tickets[a]);
+        const auto gb = groupNameFor(tickets[b]);
+        return ga != gb && ga.toString() < gb.toString();
+    });
+
+    m_tickets.clear();
+    m_tickets.reserve(tickets.size());
+    m_groups.clear();
+    for (const int i : order)
+    {
+        const auto& t = tickets[i];
+        const auto name = groupNameFor(t);
+        if (m_groups.isEmpty() || m_groups.last().name != name)
+            m_groups.append(Group{name, int(m_tickets.size()), 0, m_nextGroupId++});
+        m_tickets.append(t);
+        ++m_groups.last().count;
+    }
+    rebuildGroupLookup();
+
+    endResetModel();
+}
+
+bool TicketsModel::applyDiff(const QList<JiraTicket>& tickets)
+{
+    QHash<QString, qsizetype> newIndexByKey;
+    newIndexByKey.reserve(tickets.size());
+    for (qsizetype i = 0; i < tickets.size(); ++i)
+        newIndexByKey.insert(tickets[i].key, i);
+
+    // Size the structural change first; past a point a reset is cheaper for the view.
+    // Tickets that stay in their group count too when step 6 has to move them.
+    qsizetype structural = 0;
+    QHash<InternedString, QStringList> staying; // by group, current order
+    QSet<QString> stayingKeys;
+    for (int g = 0; g < m_groups.size(); ++g)
+    {
+        for (int r = 0; r < m_groups[g].count; ++r)
+        {
+            const auto& key = m_tickets[m_groups[g].first + r].key;
+            const auto it = newIndexByKey.constFind(key);
+            if (it == newIndexByKey.constEnd() || groupNameFor(tickets[*it]) != m_groups[g].name)
+            {
+                ++structural;
+                continue;
+            }
+            staying[m_groups[g].name].append(key);
+            stayingKeys.insert(key);
+        }
+    }
+    structural += std::max<qsizetype>(0, tickets.size() - (m_tickets.size() - structural));
+    QHash<InternedString, QStringList> stayingTarget;
+    for (const auto& t : tickets)
+        if (stayingKeys.contains(t.key))
+            stayingTarget[groupNameFor(t)].append(t.key);
+    for (auto it = staying.cbegin(); it != staying.cend(); ++it)
+        structural += reorderMoves(*it, stayingTarget.value(it.key()));
+    if (structural > std::max<qsizetype>(64, tickets.size() / 2))
+        return false;
+
+    // 1. Remove tickets that are gone, in contiguous runs, back to front.
+    for (int g = int(m_groups.size()) - 1; g >= 0; --g)
+    {
+        int r = m_groups[g].count - 1;
+        while (r >= 0)
+        {
+            if (newIndexByKey.contains(m_tickets[m_groups[g].first + r].key))
+            {
+                --r;
+                continue;
+            }
+            int start = r;
+            while (start > 0 && !newIndexByKey.contains(m_tickets[m_groups[g].first + start - 1].key))
+                --start;
+            beginRemoveRows(index(g, 0), start, r);
+            eraseTickets(g, start, r - start + 1);
+            endRemoveRows();
+            r = start - 1;
+        }
+    }
+
+    // 2. Create groups that do not exist yet (empty for now).
+    QHash<InternedString, int> groupRowByName;
+    for (int g = 0; g < m_groups.size(); ++g)
+        groupRowByName.insert(m_groups[g].name, g);
+    for (const auto& t : tickets)
+    {
+        const auto name = groupNameFor(t);
+        if (groupRowByName.contains(name))
+            continue;
+        const int row = groupInsertRow(name);
+        beginInsertRows(QModelIndex(), row, row);
+        insertGroup(row, name);
+        endInsertRows();
+        groupRowByName.clear();
+        for (int g = 0; g < m_groups.size(); ++g)
+            groupRowByName.insert(m_groups[g].name, g);
+    }
+
+    // 3. Move tickets whose sprint changed to the end of their new group.
+    for (int g = 0; g < m_groups.size(); ++g)
+    {
+        int r = 0;
+        while (r < m_groups[g].count)
+        {
+            const auto& t = tickets[newIndexByKey.value(m_tickets[m_groups[g].first + r].key)];
+            const int dest = groupRowByName.value(groupNameFor(t));
+            if (dest == g)
+            {
+                ++r;
+                continue;
+            }
+            const int destRow = m_groups[dest].count;
+            beginMoveRows(index(g, 0), r, r, index(dest, 0), destRow);
+            moveTicket(g, r, dest, destRow);
+            endMoveRows();
+        }
+    }
 
-    // Group by sprint name
-    QMap<QString, QList<JiraTicket>> groups;
+    // 4. Drop groups that ended up empty.
+    for (int g = int(m_groups.size()) - 1; g >= 0; --g)
+    {
+        if (m_groups[g].count > 0)
+            continue;
+        beginRemoveRows(QModelIndex(), g, g);
+        removeGroup(g);
+        endRemoveRows();
+    }
+    groupRowByName.clear();
+    for (int g = 0; g < m_groups.size(); ++g)
+        groupRowByName.insert(m_groups[g].name, g);
+
+    // 5. Append new tickets to their group (batched per group).
+    QSet<QString> present;
+    present.reserve(m_tickets.size());
+    for (const auto& t : m_tickets)
+        present.insert(t.key);
+    QHash<int, QList<JiraTicket>> added;
     for (const auto& t : tickets)
-        groups[t.sprint.isEmpty() ? QStringLiteral("No Sprint") : t.sprint].append(t);
+        if (!present.contains(t.key))
+            added[groupRowByName.value(groupNameFor(t))].append(t);
+    for (auto it = added.cbegin(); it != added.cend(); ++it)
+    {
+        const int g = it.key();
+        const int start = m_groups[g].count;
+        beginInsertRows(index(g, 0), start, start + int(it.value().size()) - 1);
+        for (int i = 0; i < it.value().size(); ++i)
+            insertTicket(g, start + i, it.value()[i]);
+        endInsertRows();
+    }
 
-    for (auto it = groups.begin(); it != groups.end(); ++it)
+    // 6. Restore the incoming order within each group with single-row moves; a ticket
+    //    that bubbled to the top after an update costs one move.
+    QHash<int, QStringList> targetOrder;
+    for (const auto& t : tickets)
+        targetOrder[groupRowByName.value(groupNameFor(t))].append(t.key);
+    for (int g = 0; g < m_groups.size(); ++g)
     {
-        auto* groupItem = new QStandardItem(QStringLiteral("📁 %1").arg(it.key()));
-        groupItem->setData("group", RoleType);
-        groupItem->setData(it.key(), RoleSprint);
-        groupItem->setEditable(false);
+        const auto& target = targetOrder[g];
+        for (int i = 0; i < target.size(); ++i)
+        {
+            if (m_tickets[m_groups[g].first + i].key == target[i])
+                continue;
+            int j = i + 1;
+            while (j < m_groups[g].count && m_tickets[m_groups[g].first + j].key != target[i])
+                ++j;
+            if (j >= m_groups[g].count)
+                continue;
+            const auto parent = index(g, 0);
+            beginMoveRows(parent, j, j, parent, i);
+            moveTicket(g, j, g, i);
+            endMoveRows();
+        }
+    }
 
-        for (const auto& t : it.value())
+    // 7. Refresh edited tickets in place.
+    for (int g = 0; g < m_groups.size(); ++g)
+    {
+        for (int r = 0; r < m_groups[g].count; ++r)
         {
-            auto* ticket = new QStandardItem(QStringLiteral("%1  —  %2").arg(t.key, t.summary));
-            ticket->setData("ticket", RoleType);
-            ticket->setData(t.key, RoleKey);
-            ticket->setData(t.status, RoleStatus);
-            ticket->setData(t.summary, RoleSummary);
-            ticket->setData(t.sprint, RoleSprint);
-            ticket->setEditable(false);
-            groupItem->appendRow(ticket);
+            auto& cur = m_tickets[m_groups[g].first + r];
+            const auto& next = tickets[newIndexByKey.value(cur.key)];
+            if (cur.summary == next.summary && cur.status == next.status
+                && cur.sprint == next.sprint && cur.updated == next.updated)
+                continue;
+            cur = next;
+            const auto idx = index(r, 0, index(g, 0));
+            emit dataChanged(idx, idx);
         }
+    }
+
+    return true;
+}
+
+void TicketsModel::mergeTickets(const QList<JiraTicket>& tickets)
+{
+    if (tickets.isEmpty())
+        return;
+
+    QHash<QString, int> position; // key -> index into m_tickets
+    position.reserve(m_tickets.size());
+    for (int i = 0; i < m_tickets.size(); ++i)
+        position.insert(m_tickets[i].key, i);
+
+    // 1. Edit known tickets in place; collect sprint changes and new keys.
+    QList<JiraTicket> moved;
+    QHash<InternedString, QList<JiraTicket>> added; // by group name
+    QSet<QString> seen;
+    for (const auto& t : tickets)
+    {
+        if (seen.contains(t.key))
+            continue;
+        seen.insert(t.key);
+
+        const auto it = position.constFind(t.key);
+        if (it == position.constEnd())
+        {
+            added[groupNameFor(t)].append(t);
+            continue;
+        }
+
+        auto& cur = m_tickets[*it];
+        if (groupNameFor(cur) != groupNameFor(t))
+        {
+            moved.append(t);
+            continue;
+        }
+        if (cur.summary == t.summary && cur.status == t.status && cur.sprint == t.sprint && cur.updated == t.updated)
+            continue;
+        cur = t;
+        const int g = groupOfTicket(*it);
+        const auto idx = index(*it - m_groups[g].first, 0, index(g, 0));
+        emit dataChanged(idx, idx);
+    }
+
+    // 2. Sprint changes (rare mid-refresh): move to the end of the new group. An emptied
+    //    group stays until the final setTickets().
+    for (const auto& t : moved)
+    {
+        const int dest = ensureGroup(groupNameFor(t));
+        const auto from = indexForKey(t.key);
+        const int g = groupRowForId(from.internalId());
+        const int destRow = m_groups[dest].count;
+        beginMoveRows(index(g, 0), from.row(), from.row(), index(dest, 0), destRow);
+        moveTicket(g, from.row(), dest, destRow);
+        endMoveRows();
+
+        m_tickets[m_groups[dest].first + destRow] = t;
+        const auto idx = index(destRow, 0, index(dest, 0));
+        emit dataChanged(idx, idx);
+    }
 
-        appendRow(groupItem);
+    // 3. Append new tickets, one insertion per group.
+    for (auto it = added.cbegin(); it != added.cend(); ++it)
+    {
+        const int g = ensureGroup(it.key());
+        const int start = m_groups[g].count;
+        beginInsertRows(index(g, 0), start, start + int(it.value().size()) - 1);
+        for (int i = 0; i < it.value().size(); ++i)
+            insertTicket(g, start + i, it.value()[i]);
+        endInsertRows();
     }
 }
 
+void TicketsModel::eraseTickets(int group, int row, int count)
+{
+    m_tickets.remove(m_groups[group].first + row, count);
+    m_groups[group].count -= count;
+    for (int g = group + 1; g < m_groups.size(); ++g)
+        m_groups[g].first -= count;
+}
+
+void TicketsModel::insertTicket(int group, int row, const JiraTicket& t)
+{
+    m_tickets.insert(m_groups[group].first + row, t);
+    ++m_groups[group].count;
+    for (int g = group + 1; g < m_groups.size(); ++g)
+        ++m_groups[g].first;
+}
+
+int TicketsModel::groupInsertRow(InternedString name) const
+{
+    const auto pos = std::lower_bound(m_groups.cbegin(), m_groups.cend(), name.toString(),
+                                      [](const Group& g, const QString& n) { return g.name.toString() < n; });
+    return int(pos - m_groups.cbegin());
+}
+
+void TicketsModel::insertGroup(int row, InternedString name)
+{
+    const int first = row < m_groups.size() ? m_groups[row].first : int(m_tickets.size());
+    m_groups.insert(row, Group{name, first, 0, m_nextGroupId++});
+    rebuildGroupLookup();
+}
+
+void TicketsModel::removeGroup(int group)
+{
+    Q_ASSERT(m_groups[group].count == 0);
+    m_groups.removeAt(group);
+    rebuildGroupLookup();
+}
+
+void TicketsModel::moveTicket(int fromGroup, int fromRow, int toGroup, int toRow)
+{
+    const JiraTicket t = m_tickets[m_groups[fromGroup].first + fromRow];
+    eraseTickets(fromGroup, fromRow, 1);
+    insertTicket(toGroup, toRow, t);
+}
+
 QString TicketsModel::ticketKeyForIndex(const QModelIndex& index) const
+{
+    const auto* t = ticketForIndex(index);
+    return t ? t->key : QString();
+}
+
+const JiraTicket* TicketsModel::ticketForIndex(const QModelIndex& index) const
+{
+    if (!index.isValid() || index.model() != this || index.internalId() == 0)
+        return nullptr;
+    const int g = groupRowForId(index.internalId());
+    if (g < 0 || index.row() >= m_groups[g].count)
+        return nullptr;
+    return &m_tickets[m_groups[g].first + index.row()];
+}
+
+QModelIndex TicketsModel::indexForKey(const QString& issueKey) const
+{
+    for (int g = 0; g < m_groups.size(); ++g)
+    {
+        const auto& group = m_groups[g];
+        for (int row = 0; row < group.count; ++row)
+            if (m_tickets[group.first + row].key == issueKey)
+                return createIndex(row, 0, group.id);
+    }
+    return {};
+}
+
+InternedString TicketsModel::groupName(int groupRow) const
+{
+    return groupRow >= 0 && groupRow < m_groups.size() ? m_groups[groupRow].name : InternedString();
+}
+
+QModelIndex TicketsModel::index(int row, int column, const QModelIndex& parent) const
+{
+    if (row < 0 || column != 0)
+        return {};
+
+    if (!parent.isValid())
+        return row < m_groups.size() ? createIndex(row, column, quintptr(0)) : QModelIndex();
+
+    // Only group rows have children.
+    if (parent.internalId() != 0 || parent.row() >= m_groups.size())
+        return {};
+    const auto& g = m_groups[parent.row()];
+    return row < g.count ? createIndex(row, column, g.id) : QModelIndex();
+}
+
+QModelIndex TicketsModel::parent(const QModelIndex& child) const
+{
+    if (!child.isValid() || child.internalId() == 0)
+        return {};
+    const int g = groupRowForId(child.internalId());
+    return g < 0 ? QModelIndex() : createIndex(g, 0, quintptr(0));
+}
+
+int TicketsModel::rowCount(const QModelIndex& parent) const
+{
+    if (!parent.isValid())
+        return int(m_groups.size());
+    if (parent.column() != 0 || parent.internalId() != 0 || parent.row() >= m_groups.size())
+        return 0;
+    return m_groups[parent.row()].count;
+}
+
+int TicketsModel::columnCount(const QModelIndex&) const
+{
+    return 1;
+}
+
+QVariant TicketsModel::data(const QModelIndex& index, int role) const
 {
     if (!index.isValid())
         return {};
-    const auto type = data(index, RoleType).toString();
-    if (type != "ticket")
+
+    if (index.internalId() == 0)
+    {
+        if (index.row() >= m_groups.size())
+            return {};
+        const auto& g = m_groups[index.row()];
+        switch (role)
+        {
+        case Qt::DisplayRole: return QStringLiteral("📁 %1").arg(g.name.toString());
+        case RoleType: return QStringLiteral("group");
+        case RoleSprint: return g.name.toString();
+        default: return {};
+        }
+    }
+
+    const auto* t = ticketForIndex(index);
+    if (!t)
         return {};
-    return data(index, RoleKey).toString();
+    switch (role)
+    {
+    case Qt::DisplayRole: return QStringLiteral("%1  —  %2").arg(t->key, t->summary);
+    case RoleType: return QStringLiteral("ticket");
+    case RoleKey: return t->key;
+    case RoleStatus: return t->status.toString();
+    case RoleSummary: return t->summary;
+    case RoleSprint: return t->sprint.toString();
+    default: return {};
+    }
+}
+
+QVariant TicketsModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (section == 0 && orientation == Qt::Horizontal && role == Qt::DisplayRole)
+        return QStringLiteral("Tickets");
+    return {};
+}
+
+Qt::ItemFlags TicketsModel::flags(const QModelIndex& index) const
+{
+    if (!index.isValid())
+        return Qt::NoItemFlags;
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+}
+
+int TicketsModel::groupRowForId(quintptr id) const
+{
+    return m_groupRowById.value(id, -1);
+}
+
+int TicketsModel::groupOfTicket(int ticketIndex) const
+{
+    // Groups cover m_tickets in order; empty ones share `first` with their successor.
+    const auto it = std::upper_bound(m_groups.cbegin(), m_groups.cend(), ticketIndex,
+                                     [](int i, const Group& g) { return i < g.first + g.count; });
+    return int(it - m_groups.cbegin());
+}
+
+int TicketsModel::ensureGroup(InternedString name)
+{
+    const int row = groupInsertRow(name);
+    if (row < m_groups.size() && m_groups[row].name == name)
+        return row;
+    beginInsertRows(QModelIndex(), row, row);
+    insertGroup(row, name);
+    endInsertRows();
+    return row;
+}
+
+void TicketsModel::rebuildGroupLookup()
+{
+    m_groupRowById.clear();
+    m_groupRowById.reserve(m_groups.size());
+    for (int i = 0; i < m_groups.size(); ++i)
+        m_groupRowById.insert(m_groups[i].id, i);
 }
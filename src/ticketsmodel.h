@@ -1,11 +1,15 @@
 #pragma once
 
-#include <QStandardItemModel>
+#include <QAbstractItemModel>
 #include <QHash>
+#include <QVector>
 
 #include "models.h"
 
-class TicketsModel : public QStandardItemModel
+// Two-level tree (sprint group -> ticket) over flat storage: tickets live in one vector,
+// sorted by group, and each group owns a contiguous [first, first + count) range of it.
+// Nothing is allocated per row; data() is answered on demand from the vector.
+class TicketsModel : public QAbstractItemModel
 {
     Q_OBJECT
 public:
@@ -19,8 +23,63 @@ public:
 
     explicit TicketsModel(QObject* parent = nullptr);
 
+    // Applies the new list as a keyed diff against the current one (row inserts/removes,
+    // moves between or within sprint groups, dataChanged for edited tickets), so expansion
+    // and selection survive a refresh. Falls back to a reset for the first load or when
+    // most of the list changed.
     void setTickets(const QList<JiraTicket>& tickets);
 
+    // Upserts a partial result (one page of a refresh): known keys are updated in place or
+    // moved to their new sprint group, unknown ones appended to their group. Nothing is
+    // removed; the setTickets() that follows with the full list reconciles order and drops.
+    void mergeTickets(const QList<JiraTicket>& tickets);
+
     // Returns issueKey if index corresponds to a ticket.
     QString ticketKeyForIndex(const QModelIndex& index) const;
+    const JiraTicket* ticketForIndex(const QModelIndex& index) const;
+    QModelIndex indexForKey(const QString& issueKey) const;
+
+    // Status and sprint names are InternedStrings: filters keep a bitset over their ids
+    // and grouping and diffing compare ids, never the strings.
+    InternedString groupName(int groupRow) const;
+
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex& child) const override;
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+private:
+    struct Group
+    {
+        InternedString name;
+        int first{0};
+        int count{0};
+        // Ticket indexes carry this as internalId so they can find their parent even
+        // after groups are inserted or removed around them. Group indexes carry 0.
+        quintptr id{0};
+    };
+
+    static InternedString groupNameFor(const JiraTicket& t);
+    void resetTo(const QList<JiraTicket>& tickets);
+    bool applyDiff(const QList<JiraTicket>& tickets);
+
+    // Storage edits; callers wrap them in the matching begin/end notifications.
+    void eraseTickets(int group, int row, int count);
+    void insertTicket(int group, int row, const JiraTicket& t);
+    int groupInsertRow(InternedString name) const;
+    void insertGroup(int row, InternedString name);
+    void removeGroup(int group);
+    void moveTicket(int fromGroup, int fromRow, int toGroup, int toRow);
+    int groupRowForId(quintptr id) const;
+    int groupOfTicket(int ticketIndex) const;
+    int ensureGroup(InternedString name);
+    void rebuildGroupLookup();
+
+    QVector<JiraTicket> m_tickets;
+    QVector<Group> m_groups;
+    QHash<quintptr, int> m_groupRowById;
+    quintptr m_nextGroupId{1};
 };
@@ -0,0 +1,163 @@
+#include "ticketstore.h"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+namespace
+{
+qint64 toMs(const QDateTime& dt)
+{
+    return dt.isValid() ? dt.toMSecsSinceEpoch() : TicketStore::kNoTimestamp;
+}
+
+template <typename T>
+void permute(QVector<T>& column, const QVector<qsizetype>& order)
+{
+    QVector<T> sorted;
+    sorted.reserve(column.size());
+    for (const auto row : order)
+        sorted.append(std::move(column[row]));
+    column = std::move(sorted);
+}
+} // namespace
+
+JiraTicket TicketStore::ticket(qsizetype row) const
+{
+    JiraTicket t;
+    t.key = m_keys[row];
+    t.summary = m_summaries[row];
+    t.status = m_statuses[row];
+    t.sprint = m_sprints[row];
+    if (m_updated[row] != kNoTimestamp)
+        t.updated = QDateTime::fromMSecsSinceEpoch(m_updated[row]).toUTC();
+    return t;
+}
+
+QList<JiraTicket> TicketStore::toList() const
+{
+    QList<JiraTicket> tickets;
+    tickets.reserve(size());
+    for (qsizetype row = 0; row < size(); ++row)
+        tickets.append(ticket(row));
+    return tickets;
+}
+
+void TicketStore::clear()
+{
+    m_keys.clear();
+    m_summaries.clear();
+    m_statuses.clear();
+    m_sprints.clear();
+    m_updated.clear();
+    rebuildIndexes();
+}
+
+void TicketStore::assign(const QList<JiraTicket>& tickets)
+{
+    clear();
+    m_keys.reserve(tickets.size());
+    m_summaries.reserve(tickets.size());
+    m_statuses.reserve(tickets.size());
+    m_sprints.reserve(tickets.size());
+    m_updated.reserve(tickets.size());
+    for (const auto& t : tickets)
+        append(t);
+    sortByUpdated();
+}
+
+void TicketStore::upsert(const QList<JiraTicket>& tickets)
+{
+    if (tickets.isEmpty())
+        return;
+    for (const auto& t : tickets)
+    {
+        const auto it = m_rowByKey.constFind(t.key);
+        if (it != m_rowByKey.constEnd())
+        {
+            set(*it, t);
+            continue;
+        }
+        m_rowByKey.insert(t.key, size());
+        append(t);
+    }
+    sortByUpdated();
+}
+
+qsizetype TicketStore::retain(const QSet<QString>& live)
+{
+    qsizetype kept = 0;
+    for (qsizetype row = 0; row < size(); ++row)
+    {
+        if (!live.contains(m_keys[row]))
+            continue;
+        if (kept != row)
+        {
+            m_keys[kept] = std::move(m_keys[row]);
+            m_summaries[kept] = std::move(m_summaries[row]);
+            m_statuses[kept] = m_statuses[row];
+            m_sprints[kept] = m_sprints[row];
+            m_updated[kept] = m_updated[row];
+        }
+        ++kept;
+    }
+
+    const qsizetype removed = size() - kept;
+    if (removed == 0)
+        return 0;
+    m_keys.resize(kept);
+    m_summaries.resize(kept);
+    m_statuses.resize(kept);
+    m_sprints.resize(kept);
+    m_updated.resize(kept);
+    rebuildIndexes();
+    return removed;
+}
+
+void TicketStore::append(const JiraTicket& t)
+{
+    m_keys.append(t.key);
+    m_summaries.append(t.summary);
+    m_statuses.append(t.status);
+    m_sprints.append(t.sprint);
+    m_updated.append(toMs(t.updated));
+}
+
+void TicketStore::set(qsizetype row, const JiraTicket& t)
+{
+    m_summaries[row] = t.summary;
+    m_statuses[row] = t.status;
+    m_sprints[row] = t.sprint;
+    m_updated[row] = toMs(t.updated);
+}
+
+void TicketStore::sortByUpdated()
+{
+    // Full fetches arrive sorted already; only deltas move rows.
+    if (!std::is_sorted(m_updated.cbegin(), m_updated.cend(), std::greater<qint64>()))
+    {
+        QVector<qsizetype> order(size());
+        std::iota(order.begin(), order.end(), qsizetype(0));
+        std::stable_sort(order.begin(), order.end(), [this](qsizetype a, qsizetype b) { return m_updated[a] > m_updated[b]; });
+        permute(m_keys, order);
+        permute(m_summaries, order);
+        permute(m_statuses, order);
+        permute(m_sprints, order);
+        permute(m_updated, order);
+    }
+    rebuildIndexes();
+}
+
+void TicketStore::rebuildIndexes()
+{
+    m_rowByKey.clear();
+    m_rowByKey.reserve(size());
+    m_statusSet.clear();
+    m_sprintSet.clear();
+    for (qsizetype row = 0; row < size(); ++row)
+    {
+        m_rowByKey.insert(m_keys[row], row);
+        m_statusSet.insert(m_statuses[row]);
+        m_sprintSet.insert(m_sprints[row]);
+    }
+}
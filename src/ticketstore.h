@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+#include <limits>
+
+#include "models.h"
+
+// The current ticket list stored as columns, one contiguous array per field, in Jira's
+// "updated, newest first" order. Rows are indexed by key, and the distinct statuses and
+// sprints are tracked for the filter menus. Status and sprint are interned, so matching a
+// value compares pointers.
+//
+// Columns return views into the store and copy nothing; ticket() and toList() build
+// JiraTicket values for the callers that need them. Views stay valid until the next
+// mutation.
+class TicketStore
+{
+public:
+    static constexpr qint64 kNoTimestamp = std::numeric_limits<qint64>::min();
+
+    qsizetype size() const { return m_keys.size(); }
+    bool isEmpty() const { return m_keys.isEmpty(); }
+
+    // Columns, indexed by row.
+    const QVector<QString>& keys() const { return m_keys; }
+    const QVector<QString>& summaries() const { return m_summaries; }
+    const QVector<InternedString>& statuses() const { return m_statuses; }
+    const QVector<InternedString>& sprints() const { return m_sprints; }
+    // Milliseconds since the epoch; kNoTimestamp when Jira sent none. Non-increasing.
+    const QVector<qint64>& updated() const { return m_updated; }
+
+    JiraTicket ticket(qsizetype row) const;
+    QList<JiraTicket> toList() const;
+
+    // -1 for an unknown key.
+    qsizetype rowOf(const QString& key) const { return m_rowByKey.value(key, -1); }
+    QList<InternedString> distinctStatuses() const { return m_statusSet.values(); }
+    QList<InternedString> distinctSprints() const { return m_sprintSet.values(); }
+
+    void clear();
+    void assign(const QList<JiraTicket>& tickets);
+    // Replaces rows with known keys, appends the rest, then restores the order.
+    void upsert(const QList<JiraTicket>& tickets);
+    // Drops rows whose key is not in `live`; returns how many were dropped.
+    qsizetype retain(const QSet<QString>& live);
+
+private:
+    void append(const JiraTicket& t);
+    void set(qsizetype row, const JiraTicket& t);
+    // Stable, so rows Jira already ordered keep their order; then rebuilds the indexes.
+    void sortByUpdated();
+    void rebuildIndexes();
+
+    QVector<QString> m_keys;
+    QVector<QString> m_summaries;
+    QVector<InternedString> m_statuses;
+    QVector<InternedString> m_sprints;
+    QVector<qint64> m_updated;
+
+    QHash<QString, qsizetype> m_rowByKey;
+    QSet<InternedString> m_statusSet;
+    QSet<InternedString> m_sprintSet;
+};
@@ -0,0 +1,144 @@
+#include "tracedock.h"
+
+#include "error.h"
+#include "requesttracer.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLocale>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QTimer>
+#include <QVBoxLayout>
+
+#include <algorithm>
+
+namespace {
+
+using Phase = RequestTracer::Phase;
+
+QString formatMicros(qint64 us)
+{
+    if (us <= 0) return QStringLiteral("-");
+    if (us < 1000) return QString::number(us) + QStringLiteral(" us");
+    if (us < 1000000) return QString::number(double(us) / 1000.0, 'f', 1) + QStringLiteral(" ms");
+    return QString::number(double(us) / 1000000.0, 'f', 2) + QStringLiteral(" s");
+}
+
+QString percentiles(const RequestTracer::Histogram& h)
+{
+    if (h.count() == 0) return QStringLiteral("-");
+    return formatMicros(h.percentile(0.50)) + " / " + formatMicros(h.percentile(0.95)) + " / " + formatMicros(h.percentile(0.99));
+}
+
+QString p50(const RequestTracer::Histogram& h)
+{
+    return formatMicros(h.percentile(0.50));
+}
+
+} // namespace
+
+TraceDock::TraceDock(RequestTracer& tracer, QWidget* parent)
+    : QDockWidget("Request Trace", parent),
+      m_tracer(tracer)
+{
+    setObjectName("traceDock");
+
+    auto* body = new QWidget(this);
+    auto* layout = new QVBoxLayout(body);
+    layout->setContentsMargins(4, 4, 4, 4);
+
+    m_table = new QTableWidget(0, 11, body);
+    m_table->setHorizontalHeaderLabels({"Endpoint", "Requests", "Errors", "Retries", "Total p50 / p95 / p99", "Queue p50",
+                                        "TTFB p50", "Download p50", "Parse p50", "Apply p50", "Bytes in / out"});
+    m_table->verticalHeader()->setVisible(false);
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_table->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    m_table->horizontalHeader()->setStretchLastSection(true);
+    layout->addWidget(m_table);
+
+    auto* buttons = new QHBoxLayout();
+    auto* exportButton = new QPushButton("Export Chrome Trace...", body);
+    auto* resetButton = new QPushButton("Reset", body);
+    buttons->addStretch(1);
+    buttons->addWidget(exportButton);
+    buttons->addWidget(resetButton);
+    layout->addLayout(buttons);
+    setWidget(body);
+
+    connect(exportButton, &QPushButton::clicked, this, &TraceDock::exportTrace);
+    connect(resetButton, &QPushButton::clicked, this, [this] {
+        m_tracer.reset();
+        refresh();
+    });
+
+    m_refreshTimer = new QTimer(this);
+    m_refreshTimer->setInterval(1000);
+    connect(m_refreshTimer, &QTimer::timeout, this, &TraceDock::refresh);
+}
+
+void TraceDock::showEvent(QShowEvent* event)
+{
+    QDockWidget::showEvent(event);
+    refresh();
+    m_refreshTimer->start();
+}
+
+void TraceDock::hideEvent(QHideEvent* event)
+{
+    m_refreshTimer->stop();
+    QDockWidget::hideEvent(event);
+}
+
+void TraceDock::refresh()
+{
+    auto endpoints = m_tracer.endpoints();
+    std::sort(endpoints.begin(), endpoints.end(), [](const auto* a, const auto* b) { return a->name < b->name; });
+
+    const QLocale locale;
+    m_table->setRowCount(int(endpoints.size()));
+    for (int row = 0; row < endpoints.size(); ++row)
+    {
+        const auto& e = *endpoints[row];
+        const auto phase = [&e](Phase p) -> const RequestTracer::Histogram& { return e.phases[int(p)]; };
+        const QStringList cells{
+            e.name,
+            QString::number(e.requests.load()),
+            QString::number(e.failures.load()),
+            QString::number(e.retries.load()),
+            percentiles(phase(Phase::Total)),
+            p50(phase(Phase::Queue)),
+            p50(phase(Phase::Wait)),
+            p50(phase(Phase::Download)),
+            p50(phase(Phase::Parse)),
+            p50(phase(Phase::Apply)),
+            locale.formattedDataSize(qint64(e.bytesIn.load())) + " / " + locale.formattedDataSize(qint64(e.bytesOut.load())),
+        };
+        for (int col = 0; col < cells.size(); ++col)
+        {
+            auto* item = m_table->item(row, col);
+            if (!item)
+            {
+                item = new QTableWidgetItem();
+                if (col > 0) item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+                m_table->setItem(row, col, item);
+            }
+            item->setText(cells[col]);
+        }
+    }
+}
+
+void TraceDock::exportTrace()
+{
+    const QString suggested = QDir::home().filePath(
+        QString("jiraexplorer-trace-%1.json").arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss")));
+    const QString path = QFileDialog::getSaveFileName(this, "Export Chrome Trace", suggested, "Trace JSON (*.json)");
+    if (path.isEmpty())
+        return;
+    if (!m_tracer.exportChromeTrace(path))
+        ErrorService::showError("Export trace", "Could not write " + path, this);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <QDockWidget>
+
+class RequestTracer;
+class QTableWidget;
+class QTimer;
+
+// Debug panel over RequestTracer: per-endpoint request counts, error counts, latency
+// percentiles and bytes, refreshed once a second while visible.
+class TraceDock : public QDockWidget
+{
+    Q_OBJECT
+public:
+    TraceDock(RequestTracer& tracer, QWidget* parent = nullptr);
+
+protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+
+private:
+    void refresh();
+    void exportTrace();
+
+    RequestTracer& m_tracer;
+    QTableWidget* m_table;
+    QTimer* m_refreshTimer;
+};